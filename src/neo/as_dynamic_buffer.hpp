@@ -2,6 +2,7 @@
 
 #include <neo/as_buffer.hpp>
 #include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffer_copy_accounting.hpp>
 #include <neo/dynamic_buffer.hpp>
 
 #include <neo/fwd.hpp>
@@ -57,6 +58,9 @@ public:
 private:
     wrap_ref_member_t<Container> _container;
 
+    [[no_unique_address]] detail::buffer_copy_accounting<dynamic_buffer_byte_container_adaptor>
+        _copy_acct;
+
 public:
     constexpr dynamic_buffer_byte_container_adaptor() = default;
     constexpr explicit dynamic_buffer_byte_container_adaptor(Container&& c)
@@ -97,7 +101,20 @@ public:
                    n,
                    this->max_size(),
                    this->size());
+        [[maybe_unused]] const auto init_capacity = capacity();
         container().resize(init_size + n);
+        if constexpr (buffer_copy_accounting_enabled) {
+            _copy_acct.grown(n);
+            _copy_acct.filled(n);
+            if constexpr (detail::container_has_capacity<Container>) {
+                if (capacity() != init_capacity) {
+                    // The container reallocated, moving its prior contents
+                    _copy_acct.reallocated();
+                    _copy_acct.moved(init_size);
+                }
+            }
+            _copy_acct.observe(size(), capacity());
+        }
         return data(init_size, n);
     }
 
@@ -127,10 +144,25 @@ public:
                    src.size(),
                    dest.size(),
                    n_bytes);
+        _copy_acct.moved(n_copied);
 
         const auto new_size = size() - n_bytes;
         container().resize(new_size);
     }
+
+    /**
+     * The work done by this adaptor. See NEO_BUFFER_COPY_ACCOUNTING.
+     *
+     * These are the stats of this adaptor object, not of the container. An
+     * adaptor is usually a temporary made by as_dynamic_buffer() for a single
+     * operation (as within shifting_dynamic_buffer and dynbuf_io), in which case
+     * its stats cover only that operation. The enclosing buffer adds them to its
+     * own, and buffer_copy_type_stats() totals them for every adaptor of this
+     * type.
+     */
+    [[nodiscard]] constexpr buffer_copy_stats copy_stats() const noexcept {
+        return _copy_acct.stats();
+    }
 };
 
 template <typename T>
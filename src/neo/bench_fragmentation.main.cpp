@@ -0,0 +1,242 @@
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffer_algorithm/decode.hpp>
+#include <neo/buffer_algorithm/transform.hpp>
+#include <neo/buffer_bits.hpp>
+#include <neo/bytewise_iterator.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/detail/bench_harness.hpp>
+#include <neo/mutable_buffer.hpp>
+#include <neo/pathological_buffer_range.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Measures how the buffer algorithms degrade as their input is broken into
+ * smaller segments, as happens to data read from a network. Each algorithm is
+ * run over the same data split by a pathological_buffer_range into segments of
+ * 1 byte up to 64 KiB, and its throughput is compared to that of the largest
+ * segment size.
+ *
+ * An algorithm is flagged when its per-segment overhead dominates: when
+ * splitting the data into segments of `--typical-segment` bytes (default 1460,
+ * a common TCP payload size) costs more than the work on the bytes themselves,
+ * halving its throughput.
+ *
+ * Results are written to stdout as JSON, and a chart is written to stderr.
+ *
+ * Usage: bench_fragmentation [--filter=<substring>] [--min-time=<seconds>]
+ *                            [--repetitions=<n>] [--typical-segment=<bytes>]
+ */
+
+namespace {
+
+using neo::bench::bench_runner;
+using neo::bench::do_not_optimize;
+
+constexpr std::size_t data_size        = 256 * 1024;
+constexpr std::size_t max_segment_size = 64 * 1024;
+
+std::string test_data(std::size_t size) {
+    std::string ret(size, '\0');
+    for (std::size_t i = 0; i < size; ++i) {
+        ret[i] = static_cast<char>((i * 131) ^ (i >> 5));
+    }
+    return ret;
+}
+
+/**
+ * A buffer_decoder that computes a checksum over a fixed number of bytes. The
+ * input may arrive in any number of pieces.
+ */
+struct checksum_decoder {
+    struct result {
+        std::uint32_t sum        = 0;
+        std::size_t   bytes_read = 0;
+        bool          complete   = false;
+
+        std::uint32_t value() const noexcept { return sum; }
+        bool          has_value() const noexcept { return complete; }
+        bool          has_error() const noexcept { return false; }
+    };
+
+    std::size_t   remaining = 0;
+    std::uint32_t a         = 1;
+    std::uint32_t b         = 0;
+
+    result operator()(neo::const_buffer cb) noexcept {
+        const auto n = (std::min)(cb.size(), remaining);
+        for (std::size_t i = 0; i < n; ++i) {
+            a += std::to_integer<std::uint32_t>(cb[i]);
+            b += a;
+        }
+        remaining -= n;
+        return {(b << 16) | (a & 0xffff), n, remaining == 0};
+    }
+};
+
+using fragmented_input = neo::pathological_buffer_range<neo::const_buffer>;
+/// The same segments as a fragmented_input, for algorithms that require a bidirectional range
+using segment_vector = std::vector<neo::const_buffer>;
+
+struct algorithm {
+    std::string name;
+    /// Process the given fragmented input once
+    std::function<void(const fragmented_input&, const segment_vector&)> run;
+};
+
+std::vector<algorithm> make_algorithms(std::string& out) {
+    std::vector<algorithm> algos;
+    algos.push_back({"buffer_copy", [&](auto& in, auto&) {
+                         do_not_optimize(neo::buffer_copy(neo::mutable_buffer(out), in));
+                     }});
+    algos.push_back({"buffer_transform", [&](auto& in, auto&) {
+                         auto res = neo::buffer_transform(neo::buffer_copy_transformer(),
+                                                          neo::mutable_buffer(out),
+                                                          in);
+                         do_not_optimize(res);
+                     }});
+    algos.push_back({"buffer_decode", [&](auto& in, auto&) {
+                         checksum_decoder dec{data_size};
+                         do_not_optimize(neo::buffer_decode(dec, in).value());
+                     }});
+    algos.push_back({"buffer_bits", [&](auto&, auto& segs) {
+                         neo::buffer_bits<const segment_vector> bits{segs};
+                         std::uint64_t                          acc = 0;
+                         // Stop short of the end, since reading may peek at the following byte
+                         for (std::size_t n = 0; n < data_size - 8; n += 4) {
+                             acc ^= bits.read(32);
+                         }
+                         do_not_optimize(acc);
+                     }});
+    algos.push_back({"bytewise_iterator", [&](auto& in, auto&) {
+                         std::uint32_t sum = 0;
+                         for (auto byte : neo::bytewise_iterator(in)) {
+                             sum += std::to_integer<std::uint32_t>(byte);
+                         }
+                         do_not_optimize(sum);
+                     }});
+    return algos;
+}
+
+struct sweep_point {
+    std::size_t segment_size;
+    double      bytes_per_sec;
+};
+
+/**
+ * Estimate the cost of each segment and each byte from the fastest and slowest
+ * points of the sweep, assuming time = segments * per_segment + bytes * per_byte.
+ */
+struct cost_model {
+    double per_byte_ns    = 0;
+    double per_segment_ns = 0;
+
+    static cost_model fit(const std::vector<sweep_point>& pts) {
+        auto segments = [](const sweep_point& p) {
+            return double((data_size + p.segment_size - 1) / p.segment_size);
+        };
+        auto time_ns = [](const sweep_point& p) {
+            return double(data_size) * 1e9 / p.bytes_per_sec;
+        };
+        const auto& lo = pts.front();
+        const auto& hi = pts.back();
+        cost_model  m;
+        m.per_segment_ns
+            = (std::max)(0.0, (time_ns(lo) - time_ns(hi)) / (segments(lo) - segments(hi)));
+        m.per_byte_ns
+            = (std::max)(0.0, time_ns(hi) - m.per_segment_ns * segments(hi)) / double(data_size);
+        return m;
+    }
+
+    /// The segment size at which the segment overhead equals the per-byte work
+    double break_even_segment_size() const noexcept {
+        return per_byte_ns > 0 ? per_segment_ns / per_byte_ns : 0;
+    }
+};
+
+void print_chart(const std::string& name, const std::vector<sweep_point>& pts) {
+    const auto best = std::max_element(pts.begin(), pts.end(), [](auto& l, auto& r) {
+                          return l.bytes_per_sec < r.bytes_per_sec;
+                      })->bytes_per_sec;
+    std::fprintf(stderr, "\n%s: throughput by segment size\n", name.c_str());
+    for (auto& p : pts) {
+        const auto width = static_cast<int>(50 * p.bytes_per_sec / best + 0.5);
+        std::fprintf(stderr,
+                     "%8zu B |%-50s| %10.2f MiB/s\n",
+                     p.segment_size,
+                     std::string(static_cast<std::size_t>(width), '#').c_str(),
+                     p.bytes_per_sec / (1024 * 1024));
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    // Take out the option that is specific to this program before the runner sees the rest
+    std::size_t              typical_segment = 1460;
+    std::vector<const char*> args;
+    for (int i = 0; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg.starts_with("--typical-segment=")) {
+            typical_segment = std::strtoull(argv[i] + 18, nullptr, 10);
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    bench_runner r{bench_runner::parse_args(static_cast<int>(args.size()), args.data())};
+
+    const auto src = test_data(data_size);
+    auto       out = std::string(data_size, '\0');
+
+    for (auto& algo : make_algorithms(out)) {
+        std::vector<sweep_point> pts;
+        for (std::size_t seg = 1; seg <= max_segment_size; seg *= 2) {
+            fragmented_input in{neo::const_buffer(src), seg};
+            segment_vector   segs(in.begin(), in.end());
+            auto             name = algo.name + "/segment/" + std::to_string(seg);
+            auto             res  = r.run(name, data_size, [&] { algo.run(in, segs); });
+            if (res == nullptr) {
+                continue;
+            }
+            res->counter("segment_size", double(seg))
+                .counter("segments", double((data_size + seg - 1) / seg));
+            pts.push_back({seg, res->bytes_per_sec});
+        }
+        if (pts.size() < 2) {
+            continue;
+        }
+        print_chart(algo.name, pts);
+
+        const auto model      = cost_model::fit(pts);
+        const auto break_even = model.break_even_segment_size();
+        char       text[256];
+        std::snprintf(text,
+                      sizeof text,
+                      "%s: %.2f ns per segment, %.4f ns per byte; segment overhead equals the "
+                      "per-byte work at %.0f-byte segments",
+                      algo.name.c_str(),
+                      model.per_segment_ns,
+                      model.per_byte_ns,
+                      break_even);
+        r.add_finding(text);
+        if (break_even > double(typical_segment)) {
+            std::snprintf(text,
+                          sizeof text,
+                          "%s: per-segment overhead dominates at %zu-byte segments",
+                          algo.name.c_str(),
+                          typical_segment);
+            r.add_finding(text);
+        }
+    }
+
+    r.write_json(std::cout, "fragmentation");
+}
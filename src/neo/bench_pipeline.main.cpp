@@ -0,0 +1,528 @@
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffer_algorithm/transform.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/detail/bench_harness.hpp>
+#include <neo/iostream_io.hpp>
+#include <neo/mutable_buffer.hpp>
+#include <neo/string_io.hpp>
+#include <neo/transform_io.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#define NEO_BENCH_HAVE_POSIX 1
+#else
+#define NEO_BENCH_HAVE_POSIX 0
+#endif
+
+/**
+ * Measures complete pipelines built from the library:
+ *
+ *      file -> iostream_io or fd source -> buffer_transform_source -> dynbuf_io -> file sink
+ *
+ * with an identity, hex-encoding, and checksum transform, and compares each
+ * with a hand-written loop that does the same work with read()/write() (or
+ * istream::read()/ostream::write()) and memcpy(). For each pipeline, the
+ * overhead relative to the hand-written loop, the number of heap allocations,
+ * and the peak number of heap bytes in use are reported, along with the peak
+ * RSS of the process.
+ *
+ * Results are written to stdout as JSON, and a summary is written to stderr.
+ *
+ * Usage: bench_pipeline [--filter=<substring>] [--min-time=<seconds>]
+ *                       [--repetitions=<n>] [--size-mib=<n>]
+ */
+
+namespace {
+
+/// Counts every heap allocation made by the program
+struct alloc_counters {
+    std::atomic<std::uint64_t> allocations{0};
+    std::atomic<std::uint64_t> live_bytes{0};
+    std::atomic<std::uint64_t> peak_live_bytes{0};
+
+    void reset() noexcept {
+        allocations.store(0, std::memory_order_relaxed);
+        peak_live_bytes.store(live_bytes.load(std::memory_order_relaxed),
+                              std::memory_order_relaxed);
+    }
+} g_allocs;
+
+/// Space in front of each allocation that records its size
+constexpr std::size_t alloc_header_size = alignof(std::max_align_t);
+
+void* counted_alloc(std::size_t n) {
+    auto p = static_cast<std::byte*>(std::malloc(n + alloc_header_size));
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    std::memcpy(p, &n, sizeof n);
+    g_allocs.allocations.fetch_add(1, std::memory_order_relaxed);
+    const auto live = g_allocs.live_bytes.fetch_add(n, std::memory_order_relaxed) + n;
+    auto       peak = g_allocs.peak_live_bytes.load(std::memory_order_relaxed);
+    while (peak < live
+           && !g_allocs.peak_live_bytes.compare_exchange_weak(peak,
+                                                              live,
+                                                              std::memory_order_relaxed)) {
+    }
+    return p + alloc_header_size;
+}
+
+void counted_free(void* ptr) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+    auto        p = static_cast<std::byte*>(ptr) - alloc_header_size;
+    std::size_t n = 0;
+    std::memcpy(&n, p, sizeof n);
+    g_allocs.live_bytes.fetch_sub(n, std::memory_order_relaxed);
+    std::free(p);
+}
+
+}  // namespace
+
+void* operator new(std::size_t n) { return counted_alloc(n); }
+void* operator new[](std::size_t n) { return counted_alloc(n); }
+void  operator delete(void* p) noexcept { counted_free(p); }
+void  operator delete[](void* p) noexcept { counted_free(p); }
+void  operator delete(void* p, std::size_t) noexcept { counted_free(p); }
+void  operator delete[](void* p, std::size_t) noexcept { counted_free(p); }
+
+namespace {
+
+using neo::bench::bench_result;
+using neo::bench::bench_runner;
+using neo::bench::do_not_optimize;
+
+/// The size of each read and write made by the pipelines
+constexpr std::size_t io_chunk_size = 64 * 1024;
+
+constexpr char hex_digits[] = "0123456789abcdef";
+
+/**
+ * A buffer_transformer that writes each input byte as two hex digits.
+ */
+struct hex_transformer {
+    neo::simple_transform_result operator()(neo::mutable_buffer out,
+                                            neo::const_buffer   in) const noexcept {
+        const auto n = (std::min)(in.size(), out.size() / 2);
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto b   = std::to_integer<unsigned>(in[i]);
+            out[2 * i]     = std::byte(hex_digits[b >> 4]);
+            out[2 * i + 1] = std::byte(hex_digits[b & 0xf]);
+        }
+        return {n * 2, n, false};
+    }
+};
+
+/// A simple running checksum of the bytes that pass through a pipeline
+struct running_checksum {
+    std::uint32_t a = 1;
+    std::uint32_t b = 0;
+
+    void update(const std::byte* data, std::size_t n) noexcept {
+        for (std::size_t i = 0; i < n; ++i) {
+            a += std::to_integer<std::uint32_t>(data[i]);
+            b += a;
+        }
+    }
+
+    std::uint32_t value() const noexcept { return (b << 16) | (a & 0xffff); }
+};
+
+/**
+ * A buffer_transformer that passes bytes through unchanged while computing a
+ * checksum of them.
+ */
+struct checksum_transformer {
+    running_checksum sum;
+
+    neo::simple_transform_result operator()(neo::mutable_buffer out,
+                                            neo::const_buffer   in) noexcept {
+        const auto n = (std::min)(in.size(), out.size());
+        sum.update(in.data(), n);
+        std::memcpy(out.data(), in.data(), n);
+        return {n, n, false};
+    }
+};
+
+#if NEO_BENCH_HAVE_POSIX
+
+/**
+ * read() from `fd`, retrying if interrupted. Returns zero only at the end of
+ * the file. Any other error ends the program, since it would otherwise be
+ * taken for the end of the file and silently cut the run short.
+ */
+std::size_t read_fd(int fd, void* dest, std::size_t size) {
+    while (true) {
+        const auto got = ::read(fd, dest, size);
+        if (got >= 0) {
+            return static_cast<std::size_t>(got);
+        }
+        if (errno != EINTR) {
+            std::perror("read");
+            std::exit(1);
+        }
+    }
+}
+
+/**
+ * write() to `fd`, retrying if interrupted. Returns the number of bytes
+ * written, which is non-zero. Any error ends the program.
+ */
+std::size_t write_fd(int fd, const void* data, std::size_t size) {
+    while (true) {
+        const auto put = ::write(fd, data, size);
+        if (put > 0) {
+            return static_cast<std::size_t>(put);
+        }
+        if (put == 0 || errno != EINTR) {
+            std::perror("write");
+            std::exit(1);
+        }
+    }
+}
+
+/**
+ * A buffer_source that reads from a file descriptor, reading at least
+ * io_chunk_size bytes at a time.
+ */
+class fd_source {
+    int                            _fd = -1;
+    neo::shifting_string_dynbuf_io _buffer;
+
+public:
+    explicit fd_source(int fd) noexcept
+        : _fd(fd) {}
+
+    neo::const_buffer next(std::size_t n) {
+        if (_buffer.available() < n) {
+            const auto want = (std::max)(n - _buffer.available(), io_chunk_size);
+            auto       dest = _buffer.prepare(want);
+            _buffer.commit(read_fd(_fd, dest.data(), dest.size()));
+        }
+        return _buffer.next(n);
+    }
+
+    void consume(std::size_t n) noexcept { _buffer.consume(n); }
+};
+
+/**
+ * A buffer_sink that writes to a file descriptor when bytes are committed.
+ */
+class fd_sink {
+    int                            _fd = -1;
+    neo::shifting_string_dynbuf_io _buffer;
+
+public:
+    explicit fd_sink(int fd) noexcept
+        : _fd(fd) {}
+
+    neo::mutable_buffer prepare(std::size_t n) { return _buffer.prepare(n); }
+
+    void commit(std::size_t n) {
+        _buffer.commit(n);
+        while (_buffer.available() != 0) {
+            auto       data = _buffer.next(_buffer.available());
+            _buffer.consume(write_fd(_fd, data.data(), data.size()));
+        }
+    }
+};
+
+/// The peak resident set size of the process, in KiB
+std::uint64_t peak_rss_kib() noexcept {
+    ::rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return static_cast<std::uint64_t>(usage.ru_maxrss) / 1024;
+#else
+    return static_cast<std::uint64_t>(usage.ru_maxrss);
+#endif
+}
+
+#else
+
+std::uint64_t peak_rss_kib() noexcept { return 0; }
+
+#endif
+
+/**
+ * Run the library pipeline from the source to the sink with the given
+ * transformer. Returns the number of bytes written.
+ */
+template <typename Source, typename Transform, typename Sink>
+std::size_t run_neo_pipeline(Source& src, Transform& tr, Sink& sink) {
+    neo::buffer_transform_source   xf{src, tr};
+    neo::shifting_string_dynbuf_io stage;
+    std::size_t                    total = 0;
+    while (true) {
+        neo::buffer_copy(stage, xf, io_chunk_size);
+        if (stage.available() == 0) {
+            break;
+        }
+        total += neo::buffer_copy(sink, stage);
+    }
+    return total;
+}
+
+/**
+ * The hand-written equivalent of each transform: process `n` bytes from `in`
+ * into `out`, and return the number of bytes written.
+ */
+enum class transform_kind { identity, hex, checksum };
+
+std::size_t raw_transform(transform_kind    kind,
+                          const char*       in,
+                          std::size_t       n,
+                          char*             out,
+                          running_checksum& sum) noexcept {
+    switch (kind) {
+    case transform_kind::identity:
+        std::memcpy(out, in, n);
+        return n;
+    case transform_kind::hex:
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto b   = static_cast<unsigned char>(in[i]);
+            out[2 * i]     = hex_digits[b >> 4];
+            out[2 * i + 1] = hex_digits[b & 0xf];
+        }
+        return n * 2;
+    case transform_kind::checksum:
+        sum.update(reinterpret_cast<const std::byte*>(in), n);
+        std::memcpy(out, in, n);
+        return n;
+    }
+    return 0;
+}
+
+std::size_t run_raw_iostream(transform_kind     kind,
+                             const std::string& in_path,
+                             const std::string& out_path) {
+    std::ifstream     in{in_path, std::ios::binary};
+    std::ofstream     out{out_path, std::ios::binary | std::ios::trunc};
+    std::vector<char> in_buf(io_chunk_size);
+    std::vector<char> out_buf(io_chunk_size * 2);
+    running_checksum  sum;
+    std::size_t       total = 0;
+    while (in) {
+        in.read(in_buf.data(), static_cast<std::streamsize>(in_buf.size()));
+        const auto n = static_cast<std::size_t>(in.gcount());
+        if (n == 0) {
+            break;
+        }
+        const auto m = raw_transform(kind, in_buf.data(), n, out_buf.data(), sum);
+        out.write(out_buf.data(), static_cast<std::streamsize>(m));
+        total += m;
+    }
+    do_not_optimize(sum);
+    return total;
+}
+
+template <typename Transform>
+std::size_t
+run_neo_iostream(Transform tr, const std::string& in_path, const std::string& out_path) {
+    std::ifstream    in{in_path, std::ios::binary};
+    std::ofstream    out{out_path, std::ios::binary | std::ios::trunc};
+    neo::iostream_io src{in};
+    neo::iostream_io sink{out};
+    auto             total = run_neo_pipeline(src, tr, sink);
+    do_not_optimize(tr);
+    return total;
+}
+
+#if NEO_BENCH_HAVE_POSIX
+
+struct fd_pair {
+    int in  = -1;
+    int out = -1;
+
+    fd_pair(const std::string& in_path, const std::string& out_path)
+        : in(::open(in_path.c_str(), O_RDONLY))
+        , out(::open(out_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)) {
+        if (in < 0 || out < 0) {
+            std::perror("open");
+            std::exit(1);
+        }
+    }
+
+    ~fd_pair() {
+        ::close(in);
+        ::close(out);
+    }
+
+    fd_pair(const fd_pair&) = delete;
+    fd_pair& operator=(const fd_pair&) = delete;
+};
+
+std::size_t
+run_raw_fd(transform_kind kind, const std::string& in_path, const std::string& out_path) {
+    fd_pair           fds{in_path, out_path};
+    std::vector<char> in_buf(io_chunk_size);
+    std::vector<char> out_buf(io_chunk_size * 2);
+    running_checksum  sum;
+    std::size_t       total = 0;
+    while (true) {
+        const auto got = read_fd(fds.in, in_buf.data(), in_buf.size());
+        if (got == 0) {
+            break;
+        }
+        const auto m = raw_transform(kind, in_buf.data(), got, out_buf.data(), sum);
+        for (std::size_t put = 0; put < m;) {
+            put += write_fd(fds.out, out_buf.data() + put, m - put);
+        }
+        total += m;
+    }
+    do_not_optimize(sum);
+    return total;
+}
+
+template <typename Transform>
+std::size_t run_neo_fd(Transform tr, const std::string& in_path, const std::string& out_path) {
+    fd_pair   fds{in_path, out_path};
+    fd_source src{fds.in};
+    fd_sink   sink{fds.out};
+    auto      total = run_neo_pipeline(src, tr, sink);
+    do_not_optimize(tr);
+    return total;
+}
+
+#endif
+
+/**
+ * Count the allocations made by a single call of `fn`, and add them to the
+ * result along with the peak RSS. Returns the result of `fn`.
+ */
+template <typename Fn>
+std::size_t add_memory_counters(bench_result& res, Fn&& fn) {
+    g_allocs.reset();
+    const auto live_before = g_allocs.live_bytes.load(std::memory_order_relaxed);
+    const auto ret         = fn();
+    res.counter("allocations", double(g_allocs.allocations.load(std::memory_order_relaxed)))
+        .counter("peak_heap_bytes",
+                 double(g_allocs.peak_live_bytes.load(std::memory_order_relaxed) - live_before))
+        .counter("process_peak_rss_kib", double(peak_rss_kib()));
+    return ret;
+}
+
+struct pipeline_case {
+    std::string    transform_name;
+    transform_kind kind;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    // Take out the option that is specific to this program before the runner sees the rest
+    std::size_t              size_mib = 16;
+    std::vector<const char*> args;
+    for (int i = 0; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg.starts_with("--size-mib=")) {
+            size_mib = (std::max)(std::size_t(1),
+                                  std::size_t(std::strtoull(argv[i] + 11, nullptr, 10)));
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    bench_runner r{bench_runner::parse_args(static_cast<int>(args.size()), args.data())};
+
+    const auto dir      = std::filesystem::temp_directory_path();
+    const auto in_path  = (dir / "neo-bench-pipeline.in").string();
+    const auto out_path = (dir / "neo-bench-pipeline.out").string();
+    const auto in_size  = size_mib * 1024 * 1024;
+    {
+        std::string data(in_size, '\0');
+        for (std::size_t i = 0; i < in_size; ++i) {
+            data[i] = static_cast<char>((i * 131) ^ (i >> 5));
+        }
+        std::ofstream{in_path, std::ios::binary}.write(data.data(),
+                                                       static_cast<std::streamsize>(in_size));
+    }
+
+    const pipeline_case cases[] = {
+        {"identity", transform_kind::identity},
+        {"hex", transform_kind::hex},
+        {"checksum", transform_kind::checksum},
+    };
+
+    // Run the baseline and the library pipeline for one case, and report the overhead
+    auto compare = [&](const std::string& io_name, const pipeline_case& c, auto&& raw, auto&& neo) {
+        const auto prefix  = "pipeline/" + io_name + "/" + c.transform_name;
+        auto*      raw_res = r.run(prefix + "/raw", in_size, [&] { do_not_optimize(raw()); });
+        auto*      neo_res = r.run(prefix + "/neo", in_size, [&] { do_not_optimize(neo()); });
+        if (raw_res == nullptr || neo_res == nullptr) {
+            return;
+        }
+        const auto raw_written = add_memory_counters(*raw_res, raw);
+        const auto neo_written = add_memory_counters(*neo_res, neo);
+        if (raw_written != neo_written) {
+            r.add_finding(prefix + ": the library pipeline wrote a different number of bytes");
+        }
+        const auto overhead = (neo_res->ns_per_op / raw_res->ns_per_op - 1) * 100;
+        neo_res->counter("overhead_percent", overhead);
+        char text[256];
+        std::snprintf(text,
+                      sizeof text,
+                      "%s: %+.1f%% time, %.0f vs %.0f allocations compared with the raw baseline",
+                      prefix.c_str(),
+                      overhead,
+                      neo_res->counter_value("allocations"),
+                      raw_res->counter_value("allocations"));
+        r.add_finding(text);
+    };
+
+    for (auto& c : cases) {
+        auto raw = [&] { return run_raw_iostream(c.kind, in_path, out_path); };
+        auto neo = [&]() -> std::size_t {
+            switch (c.kind) {
+            case transform_kind::identity:
+                return run_neo_iostream(neo::buffer_copy_transformer(), in_path, out_path);
+            case transform_kind::hex:
+                return run_neo_iostream(hex_transformer(), in_path, out_path);
+            case transform_kind::checksum:
+                return run_neo_iostream(checksum_transformer(), in_path, out_path);
+            }
+            return 0;
+        };
+        compare("iostream", c, raw, neo);
+    }
+#if NEO_BENCH_HAVE_POSIX
+    for (auto& c : cases) {
+        auto raw = [&] { return run_raw_fd(c.kind, in_path, out_path); };
+        auto neo = [&]() -> std::size_t {
+            switch (c.kind) {
+            case transform_kind::identity:
+                return run_neo_fd(neo::buffer_copy_transformer(), in_path, out_path);
+            case transform_kind::hex:
+                return run_neo_fd(hex_transformer(), in_path, out_path);
+            case transform_kind::checksum:
+                return run_neo_fd(checksum_transformer(), in_path, out_path);
+            }
+            return 0;
+        };
+        compare("fd", c, raw, neo);
+    }
+#endif
+
+    std::filesystem::remove(in_path);
+    std::filesystem::remove(out_path);
+
+    r.write_json(std::cout, "pipeline");
+}
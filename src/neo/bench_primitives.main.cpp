@@ -0,0 +1,232 @@
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffer_bits.hpp>
+#include <neo/buffers_cat.hpp>
+#include <neo/buffers_consumer.hpp>
+#include <neo/bytes.hpp>
+#include <neo/bytewise_iterator.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/detail/bench_harness.hpp>
+#include <neo/dynbuf_io.hpp>
+#include <neo/mutable_buffer.hpp>
+#include <neo/shifting_dynamic_buffer.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Microbenchmarks of the core buffer primitives. Results are written to stdout
+ * as JSON, and a summary is written to stderr.
+ *
+ * Usage: bench_primitives [--filter=<substring>] [--min-time=<seconds>] [--repetitions=<n>]
+ */
+
+namespace {
+
+using neo::bench::bench_runner;
+using neo::bench::do_not_optimize;
+
+/// Split `buf` into a sequence of buffers of (at most) `seg_size` bytes each
+template <typename Buffer>
+std::vector<Buffer> segment(Buffer buf, std::size_t seg_size) {
+    std::vector<Buffer> ret;
+    while (buf.size() != 0) {
+        ret.push_back(buf.first((std::min)(seg_size, buf.size())));
+        buf += ret.back().size();
+    }
+    return ret;
+}
+
+std::string test_data(std::size_t size) {
+    std::string ret(size, '\0');
+    for (std::size_t i = 0; i < size; ++i) {
+        ret[i] = static_cast<char>((i * 131) ^ (i >> 5));
+    }
+    return ret;
+}
+
+std::string size_name(std::size_t n) {
+    if (n >= 1024 * 1024 && n % (1024 * 1024) == 0) {
+        return std::to_string(n / (1024 * 1024)) + "MiB";
+    } else if (n >= 1024 && n % 1024 == 0) {
+        return std::to_string(n / 1024) + "KiB";
+    }
+    return std::to_string(n) + "B";
+}
+
+void bench_buffer_copy(bench_runner& r) {
+    for (std::size_t size : {16u, 256u, 4096u, 65536u, 1024u * 1024u}) {
+        auto src = test_data(size);
+        auto dst = std::string(size, '\0');
+        r.run("buffer_copy/contiguous/" + size_name(size), size, [&] {
+            do_not_optimize(neo::buffer_copy(neo::mutable_buffer(dst), neo::const_buffer(src)));
+        });
+    }
+    constexpr std::size_t total = 64 * 1024;
+    auto                  src   = test_data(total);
+    auto                  dst   = std::string(total, '\0');
+    for (std::size_t seg : {16u, 256u, 4096u}) {
+        auto src_segs = segment(neo::const_buffer(src), seg);
+        auto dst_segs = segment(neo::mutable_buffer(dst), seg * 3 / 2 + 1);
+        r.run("buffer_copy/segmented/" + size_name(seg), total, [&] {
+            do_not_optimize(neo::buffer_copy(dst_segs, src_segs));
+        });
+    }
+}
+
+void bench_buffers_cat(bench_runner& r) {
+    constexpr std::size_t size = 4096;
+    auto                  a    = test_data(size);
+    auto                  b    = test_data(size);
+    auto                  segs = segment(neo::const_buffer(a), 256);
+    auto                  cat  = neo::buffers_cat(neo::const_buffer(b), segs, neo::const_buffer(a));
+    r.run("buffers_cat/iterate", size * 3, [&] {
+        std::size_t n = 0;
+        for (neo::const_buffer part : cat) {
+            n += part.size();
+            do_not_optimize(part);
+        }
+        do_not_optimize(n);
+    });
+}
+
+void bench_buffers_consumer(bench_runner& r) {
+    constexpr std::size_t total = 64 * 1024;
+    auto                  data  = test_data(total);
+    auto                  segs  = segment(neo::const_buffer(data), 1000);
+    for (std::size_t step : {1u, 64u, 4096u}) {
+        r.run("buffers_consumer/consume/" + size_name(step), total, [&] {
+            neo::buffers_consumer cons{segs};
+            while (true) {
+                auto part = cons.next(step);
+                auto n    = neo::buffer_size(part);
+                if (n == 0) {
+                    break;
+                }
+                do_not_optimize(part);
+                cons.consume(n);
+            }
+        });
+    }
+}
+
+void bench_bytewise_iterator(bench_runner& r) {
+    constexpr std::size_t total = 64 * 1024;
+    auto                  data  = test_data(total);
+    auto                  segs  = segment(neo::const_buffer(data), 4096);
+    r.run("bytewise_iterator/contiguous", total, [&] {
+        std::uint32_t sum = 0;
+        auto          it  = neo::bytewise_iterator(neo::const_buffer(data));
+        for (auto b : it) {
+            sum += std::to_integer<std::uint32_t>(b);
+        }
+        do_not_optimize(sum);
+    });
+    r.run("bytewise_iterator/segmented/4KiB", total, [&] {
+        std::uint32_t sum = 0;
+        auto          it  = neo::bytewise_iterator(segs);
+        for (auto b : it) {
+            sum += std::to_integer<std::uint32_t>(b);
+        }
+        do_not_optimize(sum);
+    });
+}
+
+void bench_buffer_bits(bench_runner& r) {
+    constexpr std::size_t total = 4096;
+    auto                  data  = test_data(total);
+    for (std::size_t width : {1u, 7u, 32u}) {
+        // Leave a little slack, since peeking may look at the byte that follows
+        const auto count = (total - 8) * 8 / width;
+        const auto bytes = count * width / 8;
+        r.run("buffer_bits/read/" + std::to_string(width) + "bit", bytes, [&] {
+            neo::buffer_bits bits{neo::const_buffer(data)};
+            std::uint64_t    acc = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                acc ^= bits.read(width);
+            }
+            do_not_optimize(acc);
+        });
+        r.run("buffer_bits/write/" + std::to_string(width) + "bit", bytes, [&] {
+            neo::buffer_bits bits{neo::mutable_buffer(data)};
+            for (std::size_t i = 0; i < count; ++i) {
+                bits.write(i, width);
+            }
+            do_not_optimize(data);
+        });
+    }
+}
+
+void bench_dynbuf_io(bench_runner& r) {
+    for (std::size_t chunk : {16u, 1024u}) {
+        constexpr std::size_t total = 64 * 1024;
+        auto                  src   = test_data(chunk);
+        std::string           storage;
+        neo::dynbuf_io        io{storage};
+        r.run("dynbuf_io/prepare_commit/" + size_name(chunk), total, [&] {
+            for (std::size_t written = 0; written < total; written += chunk) {
+                auto out = io.prepare(chunk);
+                io.commit(neo::buffer_copy(out, neo::const_buffer(src)));
+            }
+            io.consume(io.available());
+        });
+    }
+}
+
+void bench_shifting_dynamic_buffer(bench_runner& r) {
+    for (std::size_t chunk : {64u, 4096u}) {
+        constexpr std::size_t        total = 64 * 1024;
+        std::string                  storage;
+        neo::shifting_dynamic_buffer buf{storage};
+        r.run("shifting_dynamic_buffer/grow_consume/" + size_name(chunk), total, [&] {
+            // Keep a backlog of bytes in the buffer so that consume() leaves data to shift
+            for (std::size_t n = 0; n < total; n += chunk) {
+                do_not_optimize(buf.grow(chunk));
+                if (buf.size() > chunk * 4) {
+                    buf.consume(chunk);
+                }
+            }
+            buf.consume(buf.size());
+        });
+    }
+}
+
+void bench_bytes(bench_runner& r) {
+    for (std::size_t size : {64u, 4096u, 65536u}) {
+        r.run("bytes/resize_zeroed/" + size_name(size), size, [&] {
+            neo::bytes b;
+            b.resize(size);
+            do_not_optimize(b);
+        });
+        r.run("bytes/resize_uninit/" + size_name(size), size, [&] {
+            neo::bytes b;
+            b.resize(size, neo::bytes::uninit);
+            do_not_optimize(b);
+        });
+        r.run("bytes/resize_doubling/" + size_name(size), size, [&] {
+            neo::bytes b;
+            for (std::size_t n = 1; n <= size; n *= 2) {
+                b.resize(n);
+            }
+            do_not_optimize(b);
+        });
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench_runner r{bench_runner::parse_args(argc, argv)};
+    bench_buffer_copy(r);
+    bench_buffers_cat(r);
+    bench_buffers_consumer(r);
+    bench_bytewise_iterator(r);
+    bench_buffer_bits(r);
+    bench_dynbuf_io(r);
+    bench_shifting_dynamic_buffer(r);
+    bench_bytes(r);
+    r.write_json(std::cout, "primitives");
+}
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <neo/byte_array.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <neo/fwd.hpp>
+#include <neo/ref_member.hpp>
+
+#include "./copy.hpp"
+#include "./transform.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace neo {
+
+/**
+ * The size of the buffer between each pair of stages in a composed_transformer.
+ * It is small enough that every tile of a short chain stays resident in L1.
+ */
+constexpr std::size_t composed_transformer_tile_size = 4096;
+
+namespace detail {
+
+/**
+ * Holds the output of one stage of a composed_transformer until the next stage
+ * consumes it.
+ */
+template <std::size_t Size>
+struct transform_tile {
+    byte_array<Size> bytes;
+    std::size_t      begin = 0;
+    std::size_t      end   = 0;
+
+    constexpr const_buffer pending() const noexcept {
+        return const_buffer(bytes.data() + begin, end - begin);
+    }
+
+    constexpr mutable_buffer prepare() noexcept {
+        if (begin == end) {
+            begin = end = 0;
+        } else if (end == Size && begin != 0) {
+            // Shift the pending bytes to the front to make room
+            std::copy(bytes.data() + begin, bytes.data() + end, bytes.data());
+            end -= begin;
+            begin = 0;
+        }
+        return mutable_buffer(bytes.data() + end, Size - end);
+    }
+
+    constexpr void commit(std::size_t n) noexcept { end += n; }
+    constexpr void consume(std::size_t n) noexcept { begin += n; }
+    constexpr void clear() noexcept { begin = end = 0; }
+};
+
+}  // namespace detail
+
+/**
+ * A buffer_transformer that passes its input through each of `Transforms` in
+ * turn. Create one with compose_transformers().
+ *
+ * Rather than keeping a dynamic buffer between each stage, the output of each
+ * stage is held in a small fixed-size tile, and the stages are run over the
+ * tiles in a loop until the input or output is exhausted. A chain of one
+ * transformer calls it directly, and a chain of none copies its input.
+ *
+ * At the end of the input (when called with an empty input buffer), each stage
+ * is called with empty input once the stages before it have been flushed.
+ */
+template <buffer_transformer... Transforms>
+class composed_transformer {
+    constexpr static std::size_t _n_stages = sizeof...(Transforms);
+    constexpr static std::size_t _n_tiles  = _n_stages ? _n_stages - 1 : 0;
+    constexpr static std::size_t _last     = _n_stages - 1;
+
+    [[no_unique_address]] std::tuple<wrap_ref_member_t<Transforms>...> _stages;
+
+    std::array<detail::transform_tile<composed_transformer_tile_size>, _n_tiles> _tiles;
+    std::array<bool, _n_stages>                                                    _done{};
+
+    struct pass_state {
+        /// Whether the input to the current stage has ended
+        bool ended;
+        /// Whether the input to the current stage has ended because a stage declared it was done
+        bool ended_by_done;
+        bool moved;
+    };
+
+    template <std::size_t I>
+    constexpr void
+    _step(mutable_buffer out, const_buffer in, simple_transform_result& acc, pass_state& ps) {
+        const_buffer stage_in;
+        if constexpr (I == 0) {
+            stage_in = in + acc.bytes_read;
+        } else {
+            stage_in = _tiles[I - 1].pending();
+        }
+
+        bool flushed = _done[I];
+        if (!_done[I] && (stage_in.size() != 0 || ps.ended)) {
+            mutable_buffer stage_out;
+            if constexpr (I == _last) {
+                stage_out = out + acc.bytes_written;
+            } else {
+                stage_out = _tiles[I].prepare();
+            }
+            auto res = buffer_transform(unref(std::get<I>(_stages)), stage_out, stage_in);
+            if constexpr (I == 0) {
+                acc.bytes_read += res.bytes_read;
+            } else {
+                _tiles[I - 1].consume(res.bytes_read);
+            }
+            if constexpr (I == _last) {
+                acc.bytes_written += res.bytes_written;
+            } else {
+                _tiles[I].commit(res.bytes_written);
+            }
+            ps.moved = ps.moved || res.bytes_read != 0 || res.bytes_written != 0;
+            if (res.done) {
+                _done[I] = true;
+                if constexpr (I != 0) {
+                    // Nothing more will be read by this stage.
+                    _tiles[I - 1].clear();
+                }
+            }
+            // The stage has finished once its input has ended and it writes nothing more
+            // despite having room to do so
+            flushed = _done[I]
+                || (ps.ended && res.bytes_read == stage_in.size() && res.bytes_written == 0
+                    && stage_out.size() != 0);
+        }
+        ps.ended_by_done = _done[I] || (ps.ended_by_done && flushed);
+        ps.ended         = flushed;
+    }
+
+    template <std::size_t... Is>
+    constexpr simple_transform_result
+    _transform(mutable_buffer out, const_buffer in, std::index_sequence<Is...>) {
+        simple_transform_result acc;
+        pass_state              ps;
+        do {
+            ps = pass_state{in.size() == 0, false, false};
+            (_step<Is>(out, in, acc, ps), ...);
+        } while (ps.moved);
+        acc.done = _done[_last] || ps.ended_by_done;
+        return acc;
+    }
+
+public:
+    constexpr composed_transformer() = default;
+
+    constexpr explicit composed_transformer(Transforms&&... trs) requires(_n_stages != 0)
+        : _stages(NEO_FWD(trs)...) {}
+
+    constexpr simple_transform_result operator()(mutable_buffer out, const_buffer in) {
+        if constexpr (_n_stages == 0) {
+            auto n = buffer_copy(out, in);
+            return {n, n, false};
+        } else if constexpr (_n_stages == 1) {
+            auto res = unref(std::get<0>(_stages))(out, in);
+            return {res.bytes_written, res.bytes_read, res.done};
+        } else {
+            return _transform(out, in, std::make_index_sequence<_n_stages>{});
+        }
+    }
+};
+
+template <typename... Transforms>
+constexpr std::size_t buffer_transform_dynamic_growth_hint_v<composed_transformer<Transforms...>>
+    = (std::max)({std::size_t(1024),
+                  buffer_transform_dynamic_growth_hint_v<std::remove_cvref_t<Transforms>>...});
+
+namespace detail {
+
+template <typename... Kept>
+struct kept_transformers {};
+
+/// The transformers kept so far, as forwarding references
+template <typename... Kept>
+using kept_refs_t = std::type_identity_t<std::tuple<Kept&&...>>;
+
+template <typename... Kept>
+constexpr auto compose_filter(kept_transformers<Kept...>, kept_refs_t<Kept...> kept) {
+    return std::apply(
+        [](auto&&... k) { return composed_transformer<Kept...>(static_cast<Kept&&>(k)...); },
+        std::move(kept));
+}
+
+template <typename... Kept, typename First, typename... Rest>
+constexpr auto compose_filter(kept_transformers<Kept...>,
+                              kept_refs_t<Kept...> kept,
+                              First&&              first,
+                              Rest&&... rest) {
+    if constexpr (buffer_transformer_is_identity_v<std::remove_cvref_t<First>>) {
+        return compose_filter(kept_transformers<Kept...>{}, std::move(kept), NEO_FWD(rest)...);
+    } else {
+        auto more = std::tuple_cat(std::move(kept), std::forward_as_tuple(NEO_FWD(first)));
+        return compose_filter(kept_transformers<Kept..., First>{},
+                              std::move(more),
+                              NEO_FWD(rest)...);
+    }
+}
+
+}  // namespace detail
+
+/**
+ * Combine the given transformers into a single buffer_transformer that feeds
+ * the output of each into the next, without an intermediate dynamic buffer.
+ * Transformers that are known to be the identity (see
+ * `buffer_transformer_is_identity_v`) are removed from the chain entirely.
+ *
+ * Transformers given as lvalues are held by reference.
+ */
+template <buffer_transformer... Transforms>
+constexpr auto compose_transformers(Transforms&&... trs) {
+    return detail::compose_filter(detail::kept_transformers<>{}, std::tuple<>{}, NEO_FWD(trs)...);
+}
+
+}  // namespace neo
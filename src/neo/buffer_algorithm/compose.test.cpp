@@ -0,0 +1,163 @@
+#include <neo/buffer_algorithm/compose.hpp>
+
+#include <neo/string_io.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cctype>
+#include <string>
+
+namespace {
+
+struct upper_transformer {
+    neo::simple_transform_result operator()(neo::mutable_buffer out, neo::const_buffer in) const {
+        auto n = (std::min)(out.size(), in.size());
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = std::byte(std::toupper(std::to_integer<int>(in[i])));
+        }
+        return {n, n, false};
+    }
+};
+
+/// Writes every byte twice
+struct doubling_transformer {
+    bool pending = false;
+    char pending_char;
+
+    neo::simple_transform_result operator()(neo::mutable_buffer out, neo::const_buffer in) {
+        neo::simple_transform_result res;
+        while (out.size() != res.bytes_written) {
+            if (pending) {
+                out[res.bytes_written++] = std::byte(pending_char);
+                pending                  = false;
+            } else if (res.bytes_read != in.size()) {
+                pending_char             = char(in[res.bytes_read++]);
+                out[res.bytes_written++] = std::byte(pending_char);
+                pending                  = true;
+            } else {
+                break;
+            }
+        }
+        return res;
+    }
+};
+
+/// Emits the number of input bytes once the input ends
+struct counting_transformer {
+    std::size_t count   = 0;
+    bool        flushed = false;
+
+    neo::simple_transform_result operator()(neo::mutable_buffer out, neo::const_buffer in) {
+        count += in.size();
+        if (in.size() != 0 || flushed) {
+            return {0, in.size(), false};
+        }
+        auto str = std::to_string(count);
+        neo::buffer_copy(out, neo::as_buffer(str));
+        flushed = true;
+        return {str.size(), 0, false};
+    }
+};
+
+/// Passes through input until it sees a '!', and then declares itself done
+struct until_bang_transformer {
+    neo::simple_transform_result operator()(neo::mutable_buffer out, neo::const_buffer in) const {
+        auto n = (std::min)(out.size(), in.size());
+        for (std::size_t i = 0; i < n; ++i) {
+            if (in[i] == std::byte{'!'}) {
+                return {i, i + 1, true};
+            }
+            out[i] = in[i];
+        }
+        return {n, n, false};
+    }
+};
+
+std::string make_text(std::size_t size) {
+    std::string ret;
+    for (std::size_t i = 0; ret.size() < size; ++i) {
+        ret += "line " + std::to_string(i) + " of the input text\n";
+    }
+    ret.resize(size);
+    return ret;
+}
+
+template <typename Tr>
+std::string run(Tr&& tr, const std::string& text) {
+    neo::string_dynbuf_io out;
+    neo::buffer_transform(tr, out, neo::as_buffer(text));
+    // Signal the end of the input
+    neo::buffer_transform(tr, out, neo::const_buffer());
+    return std::string(out.read_area_view());
+}
+
+}  // namespace
+
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::composed_transformer<upper_transformer>>);
+NEO_TEST_CONCEPT(
+    neo::buffer_transformer<neo::composed_transformer<upper_transformer, doubling_transformer>>);
+
+// Identity stages are removed
+static_assert(
+    std::is_same_v<decltype(neo::compose_transformers(neo::buffer_copy_transformer(),
+                                                      upper_transformer(),
+                                                      neo::buffer_copy_transformer())),
+                   neo::composed_transformer<upper_transformer>>);
+static_assert(std::is_same_v<decltype(neo::compose_transformers(neo::buffer_copy_transformer())),
+                             neo::composed_transformer<>>);
+
+TEST_CASE("Compose transformers") {
+    auto text = make_text(100'000);
+
+    std::string expect;
+    for (auto c : text) {
+        expect.push_back(char(std::toupper(c)));
+        expect.push_back(char(std::toupper(c)));
+    }
+
+    CHECK(run(neo::compose_transformers(upper_transformer(),
+                                        neo::buffer_copy_transformer(),
+                                        doubling_transformer()),
+              text)
+          == expect);
+
+    // The output of a stage may be many times the size of a tile
+    CHECK(run(neo::compose_transformers(doubling_transformer(),
+                                        doubling_transformer(),
+                                        doubling_transformer(),
+                                        upper_transformer()),
+              text)
+              .size()
+          == text.size() * 8);
+
+    CHECK(run(neo::compose_transformers(), text) == text);
+}
+
+TEST_CASE("Composed transformers are flushed in order") {
+    auto text = make_text(50'000);
+
+    // The counter only emits once its input ends, and the doubler must flush after it
+    auto tr = neo::compose_transformers(upper_transformer(),
+                                        counting_transformer(),
+                                        doubling_transformer());
+    CHECK(run(tr, text) == "5500000000");
+
+    // Transformers given by lvalue are held by reference
+    counting_transformer counter;
+    run(neo::compose_transformers(counter, upper_transformer()), text);
+    CHECK(counter.count == text.size());
+}
+
+TEST_CASE("A composed transformer is done when one of its stages is done") {
+    std::string text = "Hello, world! This text is ignored";
+
+    auto tr = neo::compose_transformers(upper_transformer(), until_bang_transformer());
+
+    std::string out;
+    out.resize(100);
+    auto res = neo::buffer_transform(tr, neo::as_buffer(out), neo::as_buffer(text));
+    CHECK(res.done);
+    CHECK(out.substr(0, res.bytes_written) == "HELLO, WORLD");
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <neo/buffer_n.hpp>
 #include <neo/buffer_range.hpp>
 #include <neo/buffer_sink.hpp>
 #include <neo/buffer_source.hpp>
@@ -8,6 +9,7 @@
 #include <neo/concepts.hpp>
 
 #include "./size.hpp"
+#include "./transform.hpp"
 
 #include <algorithm>
 #include <cstddef>
@@ -70,6 +72,22 @@ constexpr void ll_buffer_copy_safe(std::byte* dest, const std::byte* src, std::s
     }
 }
 
+/**
+ * Low-level buffer copier for a size that is known at compile-time. Provides
+ * intuitive results in the case of overlap.
+ */
+template <std::size_t N>
+constexpr void ll_buffer_copy_fixed(std::byte* dest, const std::byte* src) noexcept {
+#ifdef __cpp_lib_is_constant_evaluated
+    if (!std::is_constant_evaluated()) {
+        // The size is a constant, so this will be emitted inline as a few moves
+        std::memmove(dest, src, N);
+        return;
+    }
+#endif
+    ll_buffer_copy_safe(dest, src, N);
+}
+
 /**
  * Models a function that takes two pointers to std::byte arrays, the first being
  * mutable, and a size, and copies the contents from the second array into the first
@@ -102,6 +120,22 @@ buffer_copy(mutable_buffer dest, mutable_buffer src, std::size_t max_copy, Copy&
     return buffer_copy(dest, const_buffer(src), max_copy, copy);
 }
 
+/**
+ * Copy between two buffers with compile-time extents. The number of bytes to
+ * copy is computed at compile-time, so there are no runtime bounds checks.
+ */
+template <std::size_t N, std::size_t M>
+constexpr std::size_t buffer_copy(mutable_buffer_n<N> dest, const_buffer_n<M> src) noexcept {
+    constexpr std::size_t n_to_copy = (std::min)(N, M);
+    ll_buffer_copy_fixed<n_to_copy>(dest.data(), src.data());
+    return n_to_copy;
+}
+
+template <std::size_t N, std::size_t M>
+constexpr std::size_t buffer_copy(mutable_buffer_n<N> dest, mutable_buffer_n<M> src) noexcept {
+    return buffer_copy(dest, const_buffer_n<M>(src));
+}
+
 // clang-format off
 /**
  * Copy data from `src` into `dest`. `src` may be a buffer-range or a buffer-source,
@@ -200,4 +234,7 @@ public:
     }
 };
 
+template <typename Copy>
+constexpr bool buffer_transformer_is_identity_v<buffer_copy_transformer<Copy>> = true;
+
 }  // namespace neo
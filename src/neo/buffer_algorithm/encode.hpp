@@ -46,6 +46,10 @@ constexpr decltype(auto) buffer_encode(Enc&& enc, Out&& out_, T&& val)
 {
     if constexpr (single_buffer<Out>) {
         return enc(out_, val);
+    } else if constexpr (convertible_to<Out, mutable_buffer>) {
+        // A single buffer of another type (e.g. mutable_buffer_n). Encode directly
+        // into it, without going through a buffer sink.
+        return enc(mutable_buffer(out_), val);
     } else {
         buffer_encode_result_t<Enc, T> result{};
         std::size_t                    total_written = 0;
@@ -6,16 +6,33 @@
 
 namespace neo {
 
+// clang-format off
+/**
+ * A buffer range that knows its own total size in bytes without walking its
+ * buffers. The size is obtained with a `byte_size()` member function.
+ */
+template <typename T>
+concept sized_buffer_range =
+    buffer_range<T> &&
+    requires(const std::remove_reference_t<T>& r) {
+        { r.byte_size() } noexcept -> same_as<std::size_t>;
+    };
+// clang-format on
+
 /**
  * Obtain the length of a buffer sequence, in bytes.
  */
 template <buffer_range Seq>
 constexpr std::size_t buffer_size(const Seq& seq) noexcept {
-    std::size_t size = 0;
-    for (const_buffer b : seq) {
-        size += b.size();
+    if constexpr (sized_buffer_range<Seq>) {
+        return seq.byte_size();
+    } else {
+        std::size_t size = 0;
+        for (const_buffer b : seq) {
+            size += b.size();
+        }
+        return size;
     }
-    return size;
 }
 
 constexpr std::size_t buffer_size(const_buffer b) noexcept { return b.size(); }
@@ -23,24 +40,32 @@ constexpr std::size_t buffer_size(mutable_buffer b) noexcept { return b.size();
 
 template <buffer_range R>
 constexpr bool buffer_size_at_least(R&& r, std::size_t min) noexcept {
-    std::size_t size = 0;
-    for (const_buffer b : r) {
-        size += b.size();
-        if (size >= min) {
-            return true;
+    if constexpr (sized_buffer_range<R>) {
+        return r.byte_size() >= min;
+    } else {
+        std::size_t size = 0;
+        for (const_buffer b : r) {
+            size += b.size();
+            if (size >= min) {
+                return true;
+            }
         }
+        return false;
     }
-    return false;
 }
 
 template <buffer_range R>
 constexpr bool buffer_is_empty(R&& r) noexcept {
-    for (const_buffer b : r) {
-        if (b) {
-            return false;
+    if constexpr (sized_buffer_range<R>) {
+        return r.byte_size() == 0;
+    } else {
+        for (const_buffer b : r) {
+            if (b) {
+                return false;
+            }
         }
+        return true;
     }
-    return true;
 }
 
 }  // namespace neo
@@ -29,6 +29,13 @@ concept buffer_transformer =
 template <typename T>
 constexpr std::size_t buffer_transform_dynamic_growth_hint_v = 1024;
 
+/**
+ * Specialize as `true` for transformers that copy their input to their output
+ * unchanged. Such stages are elided by compose_transformers().
+ */
+template <typename T>
+constexpr bool buffer_transformer_is_identity_v = false;
+
 template <typename T, typename... Args>
 using buffer_transform_result_t = neo::invoke_result_t<T&, mutable_buffer, const_buffer, Args...>;
 
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <neo/buffer_range.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <neo/concepts.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace neo {
+
+/**
+ * Specialize as `true` for transformers that can transform a buffer in place
+ * (see `inplace_buffer_transformer`). Being callable with a single buffer is
+ * not enough on its own: the flag promises that the output is always the same
+ * size as the input.
+ */
+template <typename T>
+constexpr bool buffer_transformer_is_inplace_v = false;
+
+// clang-format off
+/**
+ * A transformer whose output is always the same size as its input, and which
+ * can therefore transform a buffer in place. It is invoked with a single
+ * mutable_buffer, and replaces the bytes of that buffer with their transformed
+ * values. Buffers given in successive calls are treated as one contiguous
+ * stream, so a transformer may keep state between calls.
+ *
+ * A type opts in by specializing `buffer_transformer_is_inplace_v`.
+ */
+template <typename T>
+concept inplace_buffer_transformer =
+    buffer_transformer_is_inplace_v<std::remove_cvref_t<T>> &&
+    neo::invocable<T&, mutable_buffer>;
+// clang-format on
+
+/**
+ * Transform every byte of the given buffer or buffer range in place. Returns
+ * the number of bytes transformed.
+ */
+template <inplace_buffer_transformer Tr, mutable_buffer_range Bufs>
+constexpr std::size_t buffer_transform_inplace(Tr&& tr, Bufs&& bufs) noexcept(
+    noexcept(tr(mutable_buffer()))) {
+    std::size_t n_transformed = 0;
+    for (mutable_buffer buf : bufs) {
+        tr(buf);
+        n_transformed += buf.size();
+    }
+    return n_transformed;
+}
+
+}  // namespace neo
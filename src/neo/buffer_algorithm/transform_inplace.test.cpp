@@ -0,0 +1,61 @@
+#include <neo/buffer_algorithm/transform_inplace.hpp>
+
+#include <neo/as_buffer.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+struct increment_transformer {
+    int n_calls = 0;
+
+    void operator()(neo::mutable_buffer buf) noexcept {
+        ++n_calls;
+        for (std::size_t i = 0; i < buf.size(); ++i) {
+            buf[i] = std::byte(std::to_integer<int>(buf[i]) + 1);
+        }
+    }
+};
+
+/// Callable with a single buffer, but not declared as an in-place transformer
+struct unflagged_transformer {
+    void operator()(neo::mutable_buffer) noexcept {}
+};
+
+}  // namespace
+
+template <>
+constexpr bool neo::buffer_transformer_is_inplace_v<increment_transformer> = true;
+
+NEO_TEST_CONCEPT(neo::inplace_buffer_transformer<increment_transformer>);
+NEO_TEST_CONCEPT(neo::inplace_buffer_transformer<increment_transformer&>);
+NEO_TEST_CONCEPT(!neo::inplace_buffer_transformer<unflagged_transformer>);
+NEO_TEST_CONCEPT(!neo::inplace_buffer_transformer<int>);
+
+TEST_CASE("Transform a single buffer in place") {
+    std::string           str = "HAL";
+    increment_transformer tr;
+    auto                  n = neo::buffer_transform_inplace(tr, neo::as_buffer(str));
+    CHECK(n == 3);
+    CHECK(str == "IBM");
+    CHECK(tr.n_calls == 1);
+}
+
+TEST_CASE("Transform a buffer range in place") {
+    std::string str1 = "HAL ";
+    std::string str2 = "9000";
+
+    std::vector<neo::mutable_buffer> bufs = {neo::as_buffer(str1), neo::as_buffer(str2)};
+
+    increment_transformer tr;
+    auto                  n = neo::buffer_transform_inplace(tr, bufs);
+    CHECK(n == 8);
+    CHECK(str1 == "IBM!");
+    CHECK(str2 == ":111");
+    CHECK(tr.n_calls == 2);
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <neo/buffer_n.hpp>
 #include <neo/buffer_range.hpp>
 #include <neo/bytewise_iterator.hpp>
 
@@ -8,6 +9,8 @@
 #include <algorithm>
 #include <cstdint>
 #include <iterator>
+#include <type_traits>
+#include <utility>
 
 namespace neo {
 
@@ -215,4 +218,94 @@ buffer_bits(const Bufs&) -> buffer_bits<Bufs>;
 template <typename Bufs>
 buffer_bits(bytewise_iterator<Bufs>) -> buffer_bits<Bufs>;
 
+template <std::size_t N>
+buffer_bits(const_buffer_n<N>) -> buffer_bits<const_buffer>;
+
+template <std::size_t N>
+buffer_bits(mutable_buffer_n<N>) -> buffer_bits<mutable_buffer>;
+
+namespace detail {
+
+/// The bits of the `Byte`th byte that fall within [BitOffset, BitOffset + BitCount)
+template <std::size_t Byte, std::size_t BitOffset, std::size_t BitCount>
+struct fixed_bit_span {
+    constexpr static std::size_t lo    = (std::max)(BitOffset, Byte * 8);
+    constexpr static std::size_t hi    = (std::min)(BitOffset + BitCount, Byte * 8 + 8);
+    constexpr static std::size_t count = hi - lo;
+    /// The shift from the low bit of the byte to the low bit of the span
+    constexpr static std::size_t shift = Byte * 8 + 8 - hi;
+    /// The number of bits in the value that follow this span
+    constexpr static std::size_t tail = BitOffset + BitCount - hi;
+    constexpr static unsigned    mask = (1u << count) - 1;
+};
+
+template <std::size_t BitOffset, std::size_t BitCount, std::size_t... Bytes>
+constexpr std::uint64_t fixed_bits_load(const std::byte* data, std::index_sequence<Bytes...>) {
+    std::uint64_t acc = 0;
+    ((acc = (acc << fixed_bit_span<Bytes, BitOffset, BitCount>::count)
+         | ((std::to_integer<unsigned>(data[Bytes])
+             >> fixed_bit_span<Bytes, BitOffset, BitCount>::shift)
+            & fixed_bit_span<Bytes, BitOffset, BitCount>::mask)),
+     ...);
+    return acc;
+}
+
+template <std::size_t BitOffset, std::size_t BitCount, std::size_t... Bytes>
+constexpr void
+fixed_bits_store(std::byte* data, std::uint64_t value, std::index_sequence<Bytes...>) {
+    auto store_one = [&](auto byte_c) {
+        using span       = fixed_bit_span<decltype(byte_c)::value, BitOffset, BitCount>;
+        const auto part  = static_cast<unsigned>(value >> span::tail) & span::mask;
+        const auto keep  = std::to_integer<unsigned>(data[byte_c]) & ~(span::mask << span::shift);
+        data[byte_c]     = static_cast<std::byte>(keep | (part << span::shift));
+    };
+    (store_one(std::integral_constant<std::size_t, Bytes>{}), ...);
+}
+
+template <std::size_t First, std::size_t... Is>
+constexpr auto offset_index_sequence(std::index_sequence<Is...>) {
+    return std::index_sequence<(First + Is)...>{};
+}
+
+template <std::size_t BitOffset, std::size_t BitCount>
+constexpr auto fixed_bits_bytes() {
+    constexpr std::size_t first = BitOffset / 8;
+    constexpr std::size_t last  = (BitOffset + BitCount - 1) / 8;
+    return offset_index_sequence<first>(std::make_index_sequence<last - first + 1>{});
+}
+
+}  // namespace detail
+
+/**
+ * Read `BitCount` bits beginning `BitOffset` bits from the start of a
+ * fixed-extent buffer, with the same high-to-low bit order as `buffer_bits`.
+ * The position is checked at compile-time, and the access is fully unrolled.
+ */
+template <std::size_t BitOffset, std::size_t BitCount, std::size_t N>
+[[nodiscard]] constexpr std::uint64_t buffer_bits_load(const_buffer_n<N> buf) noexcept {
+    static_assert(BitCount > 0 && BitCount <= 64, "Can only load between 1 and 64 bits");
+    static_assert(BitOffset + BitCount <= N * 8, "Bit range exceeds the extent of the buffer");
+    return detail::fixed_bits_load<BitOffset, BitCount>(
+        buf.data(),
+        detail::fixed_bits_bytes<BitOffset, BitCount>());
+}
+
+template <std::size_t BitOffset, std::size_t BitCount, std::size_t N>
+[[nodiscard]] constexpr std::uint64_t buffer_bits_load(mutable_buffer_n<N> buf) noexcept {
+    return buffer_bits_load<BitOffset, BitCount>(const_buffer_n<N>(buf));
+}
+
+/**
+ * Write the low `BitCount` bits of `value` into a fixed-extent buffer, beginning
+ * `BitOffset` bits from the start of the buffer. The other bits are unchanged.
+ */
+template <std::size_t BitOffset, std::size_t BitCount, std::size_t N>
+constexpr void buffer_bits_store(mutable_buffer_n<N> buf, std::uint64_t value) noexcept {
+    static_assert(BitCount > 0 && BitCount <= 64, "Can only store between 1 and 64 bits");
+    static_assert(BitOffset + BitCount <= N * 8, "Bit range exceeds the extent of the buffer");
+    detail::fixed_bits_store<BitOffset, BitCount>(buf.data(),
+                                                  value,
+                                                  detail::fixed_bits_bytes<BitOffset, BitCount>());
+}
+
 }  // namespace neo
\ No newline at end of file
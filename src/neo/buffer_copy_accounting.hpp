@@ -0,0 +1,223 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * Define NEO_BUFFER_COPY_ACCOUNTING to 1 (for the whole program) to have the
+ * dynamic buffer types count the bytes that they move and fill. When it is not
+ * enabled, the counters are compiled out entirely, and every report is zero.
+ */
+#ifndef NEO_BUFFER_COPY_ACCOUNTING
+#define NEO_BUFFER_COPY_ACCOUNTING 0
+#endif
+
+namespace neo {
+
+/**
+ * Whether copy accounting is compiled in. See NEO_BUFFER_COPY_ACCOUNTING.
+ */
+constexpr bool buffer_copy_accounting_enabled = NEO_BUFFER_COPY_ACCOUNTING;
+
+/**
+ * The work done by a dynamic buffer to manage its bytes, beyond the copies made
+ * by its users.
+ */
+struct buffer_copy_stats {
+    /// Bytes that were copied from one place to another within the buffer's storage, or from
+    /// old storage to new storage
+    std::uint64_t bytes_moved = 0;
+    /// Bytes that were initialized (usually to zero) when the buffer grew
+    std::uint64_t bytes_filled = 0;
+    /// Bytes by which the buffer's data grew
+    std::uint64_t bytes_grown = 0;
+    /// The number of times that the storage was reallocated
+    std::uint64_t reallocations = 0;
+    /// The largest size of the data that was seen
+    std::uint64_t peak_size = 0;
+    /// The largest capacity of the storage that was seen
+    std::uint64_t peak_capacity = 0;
+
+    /**
+     * The average number of times each byte added to the buffer has been moved.
+     */
+    [[nodiscard]] constexpr double move_ratio() const noexcept {
+        return bytes_grown == 0 ? 0.0 : double(bytes_moved) / double(bytes_grown);
+    }
+};
+
+namespace detail {
+
+/// The counters for every instance of one buffer type
+struct buffer_copy_type_counters {
+    using counter = std::atomic<std::uint64_t>;
+
+    counter bytes_moved{0};
+    counter bytes_filled{0};
+    counter bytes_grown{0};
+    counter reallocations{0};
+    counter peak_size{0};
+    counter peak_capacity{0};
+
+    static void bump(counter& c, std::uint64_t n) noexcept {
+        c.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    static void raise(counter& c, std::uint64_t n) noexcept {
+        auto prev = c.load(std::memory_order_relaxed);
+        while (prev < n && !c.compare_exchange_weak(prev, n, std::memory_order_relaxed)) {
+        }
+    }
+
+    buffer_copy_stats load() const noexcept {
+        buffer_copy_stats ret;
+        ret.bytes_moved   = bytes_moved.load(std::memory_order_relaxed);
+        ret.bytes_filled  = bytes_filled.load(std::memory_order_relaxed);
+        ret.bytes_grown   = bytes_grown.load(std::memory_order_relaxed);
+        ret.reallocations = reallocations.load(std::memory_order_relaxed);
+        ret.peak_size     = peak_size.load(std::memory_order_relaxed);
+        ret.peak_capacity = peak_capacity.load(std::memory_order_relaxed);
+        return ret;
+    }
+
+    void reset() noexcept {
+        for (auto* c : {&bytes_moved,
+                        &bytes_filled,
+                        &bytes_grown,
+                        &reallocations,
+                        &peak_size,
+                        &peak_capacity}) {
+            c->store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+template <typename Owner>
+inline buffer_copy_type_counters buffer_copy_counters_for{};
+
+/**
+ * A member of each accounted buffer type, which records the work done by that
+ * instance and by all instances of `Owner`. Empty when accounting is disabled.
+ */
+template <typename Owner>
+class buffer_copy_accounting {
+#if NEO_BUFFER_COPY_ACCOUNTING
+    buffer_copy_stats _stats;
+
+    constexpr static bool _at_runtime() noexcept { return !std::is_constant_evaluated(); }
+    static buffer_copy_type_counters& _type() noexcept { return buffer_copy_counters_for<Owner>; }
+#endif
+
+public:
+    constexpr void moved([[maybe_unused]] std::size_t n) noexcept {
+#if NEO_BUFFER_COPY_ACCOUNTING
+        _stats.bytes_moved += n;
+        if (_at_runtime()) {
+            _type().bump(_type().bytes_moved, n);
+        }
+#endif
+    }
+
+    constexpr void filled([[maybe_unused]] std::size_t n) noexcept {
+#if NEO_BUFFER_COPY_ACCOUNTING
+        _stats.bytes_filled += n;
+        if (_at_runtime()) {
+            _type().bump(_type().bytes_filled, n);
+        }
+#endif
+    }
+
+    constexpr void grown([[maybe_unused]] std::size_t n) noexcept {
+#if NEO_BUFFER_COPY_ACCOUNTING
+        _stats.bytes_grown += n;
+        if (_at_runtime()) {
+            _type().bump(_type().bytes_grown, n);
+        }
+#endif
+    }
+
+    constexpr void reallocated() noexcept {
+#if NEO_BUFFER_COPY_ACCOUNTING
+        _stats.reallocations += 1;
+        if (_at_runtime()) {
+            _type().bump(_type().reallocations, 1);
+        }
+#endif
+    }
+
+    /// Note the current size and capacity, to track their peaks
+    constexpr void observe([[maybe_unused]] std::size_t size,
+                           [[maybe_unused]] std::size_t capacity) noexcept {
+#if NEO_BUFFER_COPY_ACCOUNTING
+        _stats.peak_size     = (std::max)(_stats.peak_size, std::uint64_t(size));
+        _stats.peak_capacity = (std::max)(_stats.peak_capacity, std::uint64_t(capacity));
+        if (_at_runtime()) {
+            _type().raise(_type().peak_size, size);
+            _type().raise(_type().peak_capacity, capacity);
+        }
+#endif
+    }
+
+    /**
+     * Add the work that was done by an inner buffer, given its stats from
+     * before and after the work.
+     */
+    constexpr void absorb([[maybe_unused]] const buffer_copy_stats& before,
+                          [[maybe_unused]] const buffer_copy_stats& after) noexcept {
+#if NEO_BUFFER_COPY_ACCOUNTING
+        moved(after.bytes_moved - before.bytes_moved);
+        filled(after.bytes_filled - before.bytes_filled);
+        if (after.reallocations != before.reallocations) {
+            _stats.reallocations += after.reallocations - before.reallocations;
+            if (_at_runtime()) {
+                _type().bump(_type().reallocations, after.reallocations - before.reallocations);
+            }
+        }
+#endif
+    }
+
+    [[nodiscard]] constexpr buffer_copy_stats stats() const noexcept {
+#if NEO_BUFFER_COPY_ACCOUNTING
+        return _stats;
+#else
+        return {};
+#endif
+    }
+};
+
+/**
+ * Obtain the copy_stats() of the given buffer, or empty stats if it does not
+ * keep any.
+ */
+template <typename Buffer>
+constexpr buffer_copy_stats buffer_copy_stats_of([[maybe_unused]] const Buffer& b) noexcept {
+    if constexpr (requires { b.copy_stats(); }) {
+        return b.copy_stats();
+    } else {
+        return {};
+    }
+}
+
+}  // namespace detail
+
+/**
+ * Obtain the work done by every instance of the buffer type `T` so far.
+ */
+template <typename T>
+[[nodiscard]] buffer_copy_stats buffer_copy_type_stats() noexcept {
+    return detail::buffer_copy_counters_for<std::remove_cvref_t<T>>.load();
+}
+
+/**
+ * Reset the counters for every instance of the buffer type `T`. The stats of
+ * each instance are unaffected.
+ */
+template <typename T>
+void reset_buffer_copy_type_stats() noexcept {
+    detail::buffer_copy_counters_for<std::remove_cvref_t<T>>.reset();
+}
+
+}  // namespace neo
@@ -0,0 +1,95 @@
+#define NEO_BUFFER_COPY_ACCOUNTING 1
+
+#include <neo/buffer_copy_accounting.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/as_dynamic_buffer.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/bytes.hpp>
+#include <neo/dynbuf_io.hpp>
+#include <neo/shifting_dynamic_buffer.hpp>
+#include <neo/string_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+static_assert(neo::buffer_copy_accounting_enabled);
+
+TEST_CASE("Account for a container adaptor") {
+    using adaptor_type = neo::dynamic_buffer_byte_container_adaptor<std::string&>;
+    neo::reset_buffer_copy_type_stats<adaptor_type>();
+
+    std::string  str;
+    adaptor_type dbuf{str};
+    dbuf.grow(10);
+    auto stats = dbuf.copy_stats();
+    CHECK(stats.bytes_grown == 10);
+    CHECK(stats.bytes_filled == 10);
+    CHECK(stats.peak_size == 10);
+    CHECK(stats.peak_capacity >= 10);
+
+    // Consuming from the front moves the remaining bytes down
+    dbuf.consume(4);
+    CHECK(dbuf.copy_stats().bytes_moved == 6);
+
+    auto type_stats = neo::buffer_copy_type_stats<adaptor_type>();
+    CHECK(type_stats.bytes_grown == 10);
+    CHECK(type_stats.bytes_moved == 6);
+}
+
+TEST_CASE("Account for a bytes object") {
+    neo::bytes b;
+    b.resize(8);
+    b.resize(12);
+    auto stats = b.copy_stats();
+    CHECK(stats.reallocations == 2);
+    CHECK(stats.bytes_moved == 8);
+    CHECK(stats.bytes_grown == 12);
+    CHECK(stats.bytes_filled == 12);
+    CHECK(stats.peak_size == 12);
+    CHECK(stats.move_ratio() == Approx(8.0 / 12.0));
+}
+
+TEST_CASE("Account for a shifting buffer") {
+    std::string                  str;
+    neo::shifting_dynamic_buffer dbuf{str};
+    dbuf.grow(1000);
+    dbuf.consume(900);
+    // The storage is only 1024 bytes, so this shifts the 100 remaining bytes to the front
+    dbuf.grow(100);
+    auto stats = dbuf.copy_stats();
+    CHECK(stats.bytes_grown == 1100);
+    CHECK(stats.bytes_moved == 100);
+    // The storage was grown by 1024 zero bytes
+    CHECK(stats.bytes_filled == 1024);
+    CHECK(stats.peak_size == 1000);
+    CHECK(stats.peak_capacity == 1024);
+}
+
+TEST_CASE("Account for a dynbuf_io") {
+    neo::string_dynbuf_io io;
+    neo::buffer_copy(io, neo::as_buffer(std::string(100, 'a')));
+    io.consume(60);
+    auto stats = io.copy_stats();
+    CHECK(stats.bytes_grown == 100);
+    CHECK(stats.peak_size == 100);
+    // Consuming moved the 40 unconsumed bytes to the front of the string
+    CHECK(stats.bytes_moved == 40);
+    CHECK(neo::buffer_copy_type_stats<neo::string_dynbuf_io::dynbuf_io>().bytes_moved >= 40);
+}
+
+TEST_CASE("A dynbuf_io reports the peak capacity of its storage") {
+    neo::string_dynbuf_io io;
+    neo::buffer_copy(io, neo::as_buffer(std::string(100, 'a')));
+    CHECK(io.copy_stats().peak_capacity >= io.storage().capacity());
+
+    neo::shifting_string_dynbuf_io shifting_io;
+    neo::buffer_copy(shifting_io, neo::as_buffer(std::string(100, 'a')));
+    shifting_io.consume(100);
+    neo::buffer_copy(shifting_io, neo::as_buffer(std::string(10, 'a')));
+    // The storage's capacity, rather than the size of the data in the buffer
+    CHECK(shifting_io.copy_stats().peak_capacity
+          == shifting_io.buffer().copy_stats().peak_capacity);
+    CHECK(shifting_io.copy_stats().peak_capacity > shifting_io.buffer().size());
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <neo/byte_array.hpp>
+#include <neo/byte_pointer.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/detail/single_buffer_iter.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <neo/assert.hpp>
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace neo {
+
+template <std::size_t N>
+class const_buffer_n;
+
+template <std::size_t N>
+class mutable_buffer_n;
+
+namespace detail {
+
+/**
+ * Common implementation of buffers with a compile-time extent. Only the data
+ * pointer is stored. The size is part of the type.
+ */
+template <typename P, std::size_t N, template <std::size_t> class Self, typename DynamicBuffer>
+class buffer_n_base {
+public:
+    using pointer             = P;
+    using size_type           = std::size_t;
+    using dynamic_buffer_type = DynamicBuffer;
+
+    /// The number of bytes viewed by the buffer
+    constexpr static size_type extent = N;
+
+private:
+    pointer _data = nullptr;
+
+public:
+    constexpr buffer_n_base() noexcept = default;
+    constexpr explicit buffer_n_base(pointer p) noexcept
+        : _data(p) {}
+
+    [[nodiscard]] constexpr pointer          data() const noexcept { return _data; }
+    [[nodiscard]] constexpr pointer          data_end() const noexcept { return _data + N; }
+    [[nodiscard]] constexpr static size_type size() noexcept { return N; }
+    [[nodiscard]] constexpr static bool      empty() noexcept { return N == 0; }
+
+    [[nodiscard]] constexpr std::remove_pointer_t<pointer>&
+    operator[](size_type offset) const noexcept {
+        neo_assert(expects, offset < N, "Buffer index is out-of-range", offset, N);
+        return _data[offset];
+    }
+
+    /**
+     * Obtain a buffer viewing `Len` bytes beginning at `Offset`. The bounds are
+     * checked at compile-time.
+     */
+    template <size_type Offset, size_type Len = N - Offset>
+    [[nodiscard]] constexpr Self<Len> subbuffer() const noexcept {
+        static_assert(Offset <= N && Len <= N - Offset,
+                      "subbuffer() bounds exceed the extent of the buffer");
+        return Self<Len>(_data + Offset);
+    }
+
+    template <size_type Len>
+    [[nodiscard]] constexpr Self<Len> first() const noexcept {
+        return subbuffer<0, Len>();
+    }
+
+    template <size_type Len>
+    [[nodiscard]] constexpr Self<Len> last() const noexcept {
+        static_assert(Len <= N, "last() length exceeds the extent of the buffer");
+        return subbuffer<N - Len, Len>();
+    }
+
+    /**
+     * Obtain a buffer with a runtime size that views the same bytes.
+     */
+    [[nodiscard]] constexpr dynamic_buffer_type as_buffer() const noexcept {
+        return dynamic_buffer_type(_data, N);
+    }
+
+    constexpr operator dynamic_buffer_type() const noexcept { return as_buffer(); }
+
+    constexpr auto begin() const noexcept { return detail::single_buffer_iter(as_buffer()); }
+    constexpr auto end() const noexcept { return detail::single_buffer_iter_sentinel(); }
+};
+
+}  // namespace detail
+
+/**
+ * A view of exactly `N` bytes of readonly memory. The size is known at
+ * compile-time, so copies between fixed-extent buffers compile to fixed-size
+ * moves. Converts implicitly to `const_buffer`.
+ */
+template <std::size_t N>
+class const_buffer_n
+    : public detail::buffer_n_base<const std::byte*, N, const_buffer_n, const_buffer> {
+public:
+    using const_buffer_n::buffer_n_base::buffer_n_base;
+};
+
+/**
+ * A view of exactly `N` bytes of mutable memory. Converts implicitly to
+ * `mutable_buffer`, `const_buffer`, and `const_buffer_n<N>`.
+ */
+template <std::size_t N>
+class mutable_buffer_n
+    : public detail::buffer_n_base<std::byte*, N, mutable_buffer_n, mutable_buffer> {
+public:
+    using mutable_buffer_n::buffer_n_base::buffer_n_base;
+
+    constexpr operator const_buffer_n<N>() const noexcept {
+        return const_buffer_n<N>(this->data());
+    }
+    constexpr operator const_buffer() const noexcept { return const_buffer(this->as_buffer()); }
+};
+
+/**
+ * Create a fixed-extent buffer viewing the given byte_array, std::array, or
+ * C array of trivial objects.
+ */
+template <std::size_t N>
+[[nodiscard]] constexpr mutable_buffer_n<N> as_buffer_n(byte_array<N>& arr) noexcept {
+    return mutable_buffer_n<N>(arr.data());
+}
+
+template <std::size_t N>
+[[nodiscard]] constexpr const_buffer_n<N> as_buffer_n(const byte_array<N>& arr) noexcept {
+    return const_buffer_n<N>(arr.data());
+}
+
+template <buffer_safe T, std::size_t N>
+[[nodiscard]] constexpr auto as_buffer_n(std::array<T, N>& arr) noexcept {
+    return mutable_buffer_n<sizeof(T) * N>(byte_pointer(arr.data()));
+}
+
+template <buffer_safe T, std::size_t N>
+[[nodiscard]] constexpr auto as_buffer_n(const std::array<T, N>& arr) noexcept {
+    return const_buffer_n<sizeof(T) * N>(byte_pointer(arr.data()));
+}
+
+template <buffer_safe_cvr T, std::size_t N>
+[[nodiscard]] constexpr auto as_buffer_n(T (&arr)[N]) noexcept {
+    if constexpr (std::is_const_v<T>) {
+        return const_buffer_n<sizeof(T) * N>(byte_pointer(arr));
+    } else {
+        return mutable_buffer_n<sizeof(T) * N>(byte_pointer(arr));
+    }
+}
+
+/**
+ * Create a fixed-extent buffer viewing a string literal. As with `const_buffer`,
+ * the null terminator is not included.
+ */
+template <std::size_t N>
+[[nodiscard]] constexpr const_buffer_n<N - 1> as_buffer_n(const char (&str)[N]) noexcept {
+    return const_buffer_n<N - 1>(byte_pointer(str));
+}
+
+}  // namespace neo
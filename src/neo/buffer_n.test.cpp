@@ -0,0 +1,129 @@
+#include <neo/buffer_n.hpp>
+
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffer_algorithm/encode.hpp>
+#include <neo/buffer_bits.hpp>
+#include <neo/buffer_range.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstdint>
+
+using namespace std::literals;
+
+NEO_TEST_CONCEPT(neo::buffer_range<neo::const_buffer_n<8>>);
+NEO_TEST_CONCEPT(neo::mutable_buffer_range<neo::mutable_buffer_n<8>>);
+NEO_TEST_CONCEPT(std::convertible_to<neo::mutable_buffer_n<8>, neo::const_buffer_n<8>>);
+NEO_TEST_CONCEPT(std::convertible_to<neo::mutable_buffer_n<8>, neo::const_buffer>);
+NEO_TEST_CONCEPT(std::convertible_to<neo::const_buffer_n<8>, neo::const_buffer>);
+NEO_TEST_CONCEPT(sizeof(neo::const_buffer_n<40>) == sizeof(void*));
+
+static_assert(neo::buffer_bits_load<4, 8>(neo::as_buffer_n(neo::byte_array{std::byte{0x12},
+                                                                          std::byte{0x34}}))
+              == 0x23);
+
+TEST_CASE("Create fixed-extent buffers") {
+    neo::byte_array<16> arr{};
+    auto                buf = neo::as_buffer_n(arr);
+    static_assert(decltype(buf)::extent == 16);
+    CHECK(buf.data() == arr.data());
+
+    std::array<std::uint32_t, 4> ints{};
+    static_assert(decltype(neo::as_buffer_n(ints))::extent == 16);
+
+    const std::uint16_t shorts[3] = {};
+    auto                cbuf      = neo::as_buffer_n(shorts);
+    static_assert(std::is_same_v<decltype(cbuf), neo::const_buffer_n<6>>);
+
+    // String literals do not include the null terminator
+    static_assert(decltype(neo::as_buffer_n("Hello"))::extent == 5);
+
+    auto mid = buf.subbuffer<4, 8>();
+    static_assert(decltype(mid)::extent == 8);
+    CHECK(mid.data() == arr.data() + 4);
+    CHECK(buf.last<2>().data() == arr.data() + 14);
+
+    // Dynamic views of the same memory
+    neo::mutable_buffer dyn = mid;
+    CHECK(dyn.size() == 8);
+    CHECK(neo::as_buffer(mid).size() == 8);
+}
+
+TEST_CASE("Copy between fixed-extent buffers") {
+    neo::byte_array<8> header{};
+    auto               src = neo::as_buffer_n("abcdefghijk");
+
+    auto n = neo::buffer_copy(neo::as_buffer_n(header), src);
+    CHECK(n == 8);
+    CHECK(neo::const_buffer(neo::as_buffer_n(header)).equals_string("abcdefgh"sv));
+
+    n = neo::buffer_copy(neo::as_buffer_n(header).first<2>(), neo::as_buffer_n("XYZ"));
+    CHECK(n == 2);
+    CHECK(neo::const_buffer(neo::as_buffer_n(header)).equals_string("XYcdefgh"sv));
+
+    // Fixed-extent buffers can still be used with the generic copy
+    std::string str = "........";
+    neo::buffer_copy(neo::as_buffer(str), neo::as_buffer_n(header).subbuffer<2>());
+    CHECK(str == "cdefgh..");
+}
+
+namespace {
+
+struct u16_encoder {
+    struct result {
+        std::size_t bytes_written = 0;
+        bool        done() const noexcept { return bytes_written == 2; }
+    };
+
+    result operator()(neo::mutable_buffer mb, std::uint16_t v) const noexcept {
+        if (mb.size() < 2) {
+            return {};
+        }
+        mb[0] = std::byte(v >> 8);
+        mb[1] = std::byte(v);
+        return {2};
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Encode into a fixed-extent buffer") {
+    neo::byte_array<2> out{};
+    auto res = neo::buffer_encode(u16_encoder(), neo::as_buffer_n(out), std::uint16_t(0x1234));
+    CHECK(res.done());
+    CHECK(out[0] == std::byte{0x12});
+    CHECK(out[1] == std::byte{0x34});
+}
+
+TEST_CASE("Load and store bits at fixed positions") {
+    neo::byte_array<8> arr{};
+    auto               buf = neo::as_buffer_n(arr);
+
+    neo::buffer_bits_store<0, 4>(buf, 0x4);
+    neo::buffer_bits_store<4, 4>(buf, 0x5);
+    neo::buffer_bits_store<8, 16>(buf, 0xbeef);
+    neo::buffer_bits_store<27, 11>(buf, 0x7ff);
+    CHECK(arr[0] == std::byte{0x45});
+    CHECK(arr[1] == std::byte{0xbe});
+    CHECK(arr[2] == std::byte{0xef});
+
+    CHECK(neo::buffer_bits_load<0, 4>(buf) == 0x4);
+    CHECK(neo::buffer_bits_load<8, 16>(buf) == 0xbeef);
+    CHECK(neo::buffer_bits_load<27, 11>(buf) == 0x7ff);
+    CHECK(neo::buffer_bits_load<24, 3>(buf) == 0);
+    CHECK(neo::buffer_bits_load<38, 2>(buf) == 0);
+
+    // Agrees with the runtime bit reader
+    neo::buffer_bits bits{buf};
+    CHECK(bits.read(8) == 0x45);
+    CHECK(bits.read(16) == 0xbeef);
+    bits.skip(3);
+    CHECK(bits.read(11) == 0x7ff);
+
+    neo::buffer_bits_store<0, 64>(buf, 0x0102030405060708);
+    CHECK(neo::buffer_bits_load<0, 64>(buf) == 0x0102030405060708);
+    CHECK(neo::buffer_bits_load<60, 4>(buf) == 0x8);
+}
@@ -0,0 +1,546 @@
+#pragma once
+
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffer_algorithm/transform.hpp>
+#include <neo/buffer_sink.hpp>
+#include <neo/buffer_source.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/detail/cache_line.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <neo/assert.hpp>
+#include <neo/fwd.hpp>
+#include <neo/ref_member.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace neo {
+
+/**
+ * Tuning for a buffer_pipeline.
+ */
+struct buffer_pipeline_options {
+    /// The size of each chunk that is passed between stages
+    std::size_t chunk_size = 64 * 1024;
+    /// The number of chunks in flight between each pair of adjacent stages
+    std::size_t queue_depth = 4;
+};
+
+/**
+ * A snapshot of the counters of one stage of a buffer_pipeline.
+ */
+struct buffer_pipeline_stage_stats {
+    /// The number of bytes the stage has received
+    std::uint64_t bytes_in = 0;
+    /// The number of bytes the stage has produced
+    std::uint64_t bytes_out = 0;
+    /// Time spent waiting for the previous stage to produce a chunk
+    std::chrono::nanoseconds input_stall{};
+    /// Time spent waiting for the next stage to release a chunk
+    std::chrono::nanoseconds output_stall{};
+};
+
+/**
+ * The outcome of running a buffer_pipeline.
+ */
+struct buffer_pipeline_result {
+    /// The number of bytes written to the sink
+    std::uint64_t bytes_written = 0;
+    /// Set if the sink stopped accepting bytes before the end of the stream. The
+    /// bytes that it did not accept are discarded.
+    bool sink_full = false;
+};
+
+namespace detail {
+
+struct pipeline_chunk {
+    std::unique_ptr<std::byte[]> data;
+    std::size_t                  size = 0;
+    bool                         last = false;
+};
+
+struct alignas(cache_line_size) pipeline_stage_counters {
+    std::atomic<std::uint64_t> bytes_in{0};
+    std::atomic<std::uint64_t> bytes_out{0};
+    std::atomic<std::uint64_t> input_stall_ns{0};
+    std::atomic<std::uint64_t> output_stall_ns{0};
+
+    static void add(std::atomic<std::uint64_t>& c, std::uint64_t n) noexcept {
+        // Each counter has a single writer, so this need not be a read-modify-write
+        c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    void reset() noexcept {
+        bytes_in        = 0;
+        bytes_out       = 0;
+        input_stall_ns  = 0;
+        output_stall_ns = 0;
+    }
+
+    buffer_pipeline_stage_stats snapshot() const noexcept {
+        return {
+            bytes_in.load(std::memory_order_relaxed),
+            bytes_out.load(std::memory_order_relaxed),
+            std::chrono::nanoseconds(input_stall_ns.load(std::memory_order_relaxed)),
+            std::chrono::nanoseconds(output_stall_ns.load(std::memory_order_relaxed)),
+        };
+    }
+};
+
+/**
+ * The connection between two adjacent pipeline stages. A fixed set of chunks
+ * circulates between the producing stage and the consuming stage: the producer
+ * takes free chunks, fills them, and pushes them to the consumer, which hands
+ * them back once it is done with them. Chunks are passed by pointer, so bytes
+ * are never copied between stages. When no free chunk is available, the
+ * producer blocks, which bounds the memory in flight.
+ */
+class pipeline_link {
+    std::vector<pipeline_chunk>  _chunks;
+    std::vector<pipeline_chunk*> _free;
+    std::deque<pipeline_chunk*>  _full;
+    std::mutex                   _mutex;
+    std::condition_variable      _cv;
+    bool                         _aborted = false;
+
+    template <typename Pred>
+    bool _wait(std::unique_lock<std::mutex>& lk, std::atomic<std::uint64_t>& stall, Pred pred) {
+        if (pred() || _aborted) {
+            return !_aborted;
+        }
+        const auto start = std::chrono::steady_clock::now();
+        _cv.wait(lk, [&] { return pred() || _aborted; });
+        const auto dur = std::chrono::steady_clock::now() - start;
+        pipeline_stage_counters::add(
+            stall,
+            std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(dur).count()));
+        return !_aborted;
+    }
+
+public:
+    pipeline_link(std::size_t depth, std::size_t chunk_size)
+        : _chunks(depth) {
+        for (auto& c : _chunks) {
+            c.data.reset(new std::byte[chunk_size]);
+            _free.push_back(&c);
+        }
+    }
+
+    /// Obtain a free chunk to fill. Returns null if the pipeline is aborted.
+    pipeline_chunk* acquire(std::atomic<std::uint64_t>& stall) {
+        std::unique_lock lk{_mutex};
+        if (!_wait(lk, stall, [&] { return !_free.empty(); })) {
+            return nullptr;
+        }
+        auto c = _free.back();
+        _free.pop_back();
+        return c;
+    }
+
+    void push(pipeline_chunk* c) {
+        {
+            std::lock_guard lk{_mutex};
+            _full.push_back(c);
+        }
+        _cv.notify_all();
+    }
+
+    /// Obtain the next filled chunk. Returns null if the pipeline is aborted.
+    pipeline_chunk* pop(std::atomic<std::uint64_t>& stall) {
+        std::unique_lock lk{_mutex};
+        if (!_wait(lk, stall, [&] { return !_full.empty(); })) {
+            return nullptr;
+        }
+        auto c = _full.front();
+        _full.pop_front();
+        return c;
+    }
+
+    void release(pipeline_chunk* c) {
+        {
+            std::lock_guard lk{_mutex};
+            _free.push_back(c);
+        }
+        _cv.notify_all();
+    }
+
+    void abort() {
+        {
+            std::lock_guard lk{_mutex};
+            _aborted = true;
+        }
+        _cv.notify_all();
+    }
+};
+
+}  // namespace detail
+
+/**
+ * Runs a buffer_source through a chain of buffer_transformers into a
+ * buffer_sink, with every stage running concurrently.
+ *
+ * The first stage reads from the source, each transformer is a stage of its
+ * own, and the final stage writes to the sink. Adjacent stages are connected by
+ * a bounded queue of fixed-size chunks, so a slow stage applies backpressure to
+ * those before it. The byte counts and stall times of each stage may be read
+ * with `stats()` while the pipeline runs, from any thread.
+ *
+ * The source is read until it yields no bytes at all, which is taken to be the
+ * end of its data. At the end of the input, each transformer is called with
+ * empty input until it produces no more output, allowing it to flush any
+ * buffered state. A transformer that reports `done` ends the stream at that
+ * stage. A transformer that neither reads nor writes anything while it has
+ * input and room for output is broken, and fails the pipeline with a
+ * `std::logic_error`.
+ */
+template <buffer_source Source, buffer_sink Sink, buffer_transformer... Transforms>
+class buffer_pipeline {
+public:
+    /// The number of stages: One each for the source, each transformer, and the sink
+    constexpr static std::size_t stage_count = sizeof...(Transforms) + 2;
+
+private:
+    [[no_unique_address]] wrap_ref_member_t<Source>                    _source;
+    [[no_unique_address]] wrap_ref_member_t<Sink>                      _sink;
+    [[no_unique_address]] std::tuple<wrap_ref_member_t<Transforms>...> _transforms;
+
+    buffer_pipeline_options _opts;
+
+    std::array<detail::pipeline_stage_counters, stage_count> _counters;
+
+    using links_type = std::vector<std::unique_ptr<detail::pipeline_link>>;
+
+    struct run_state {
+        links_type         links;
+        std::mutex         mutex;
+        std::exception_ptr error;
+        /// Written only by the sink stage
+        bool sink_full = false;
+
+        void fail(std::exception_ptr e) {
+            {
+                std::lock_guard lk{mutex};
+                if (!error) {
+                    error = e;
+                }
+            }
+            abort();
+        }
+
+        void abort() {
+            for (auto& l : links) {
+                l->abort();
+            }
+        }
+    };
+
+    void _run_source(run_state& st) {
+        auto& out = *st.links.front();
+        auto& ctr = _counters.front();
+        while (true) {
+            auto chunk = out.acquire(ctr.output_stall_ns);
+            if (!chunk) {
+                return;
+            }
+            // A short read is not the end of the source. Only an empty read is.
+            chunk->size = 0;
+            while (chunk->size != _opts.chunk_size) {
+                const auto n_read
+                    = buffer_copy(mutable_buffer(chunk->data.get() + chunk->size,
+                                                 _opts.chunk_size - chunk->size),
+                                  unref(_source));
+                if (n_read == 0) {
+                    break;
+                }
+                chunk->size += n_read;
+            }
+            chunk->last = chunk->size < _opts.chunk_size;
+            detail::pipeline_stage_counters::add(ctr.bytes_in, chunk->size);
+            detail::pipeline_stage_counters::add(ctr.bytes_out, chunk->size);
+            out.push(chunk);
+            if (chunk->last) {
+                return;
+            }
+        }
+    }
+
+    template <typename Tr>
+    void _run_transform(Tr&                              tr,
+                        detail::pipeline_link&           in,
+                        detail::pipeline_link&           out,
+                        detail::pipeline_stage_counters& ctr) {
+        detail::pipeline_chunk* out_chunk = nullptr;
+        bool                    done      = false;
+        while (true) {
+            auto in_chunk = in.pop(ctr.input_stall_ns);
+            if (!in_chunk) {
+                return;
+            }
+            auto       in_buf = const_buffer(in_chunk->data.get(), in_chunk->size);
+            const bool last   = in_chunk->last;
+            detail::pipeline_stage_counters::add(ctr.bytes_in, in_buf.size());
+            while (!done) {
+                if (!out_chunk) {
+                    out_chunk = out.acquire(ctr.output_stall_ns);
+                    if (!out_chunk) {
+                        return;
+                    }
+                    out_chunk->size = 0;
+                }
+                auto out_buf = mutable_buffer(out_chunk->data.get() + out_chunk->size,
+                                              _opts.chunk_size - out_chunk->size);
+                auto res     = buffer_transform(tr, out_buf, in_buf);
+                if (!res.done && res.bytes_read == 0 && res.bytes_written == 0 && !in_buf.empty()) {
+                    // A malformed transformer (see buffer_transform()). Calling it again with
+                    // the same buffers would spin forever.
+                    throw std::logic_error(
+                        "A buffer_pipeline transformer made no progress on its input");
+                }
+                in_buf += res.bytes_read;
+                out_chunk->size += res.bytes_written;
+                detail::pipeline_stage_counters::add(ctr.bytes_out, res.bytes_written);
+                done = res.done;
+                if (out_chunk->size == _opts.chunk_size) {
+                    out_chunk->last = false;
+                    out.push(std::exchange(out_chunk, nullptr));
+                } else if (in_buf.empty() && (!last || res.bytes_written == 0)) {
+                    // Wait for more input, or we have finished flushing at the end of the input
+                    break;
+                }
+            }
+            in.release(in_chunk);
+            if (last || done) {
+                break;
+            }
+        }
+        // Send the final chunk to the next stage
+        if (!out_chunk) {
+            out_chunk = out.acquire(ctr.output_stall_ns);
+            if (!out_chunk) {
+                return;
+            }
+            out_chunk->size = 0;
+        }
+        out_chunk->last = true;
+        out.push(out_chunk);
+        if (done) {
+            // Discard any input that remains, so that the stages before us can finish
+            while (auto in_chunk = in.pop(ctr.input_stall_ns)) {
+                const bool last = in_chunk->last;
+                in.release(in_chunk);
+                if (last) {
+                    break;
+                }
+            }
+        }
+    }
+
+    void _run_sink(run_state& st) {
+        auto& in  = *st.links.back();
+        auto& ctr = _counters.back();
+        while (auto chunk = in.pop(ctr.input_stall_ns)) {
+            auto buf = const_buffer(chunk->data.get(), chunk->size);
+            detail::pipeline_stage_counters::add(ctr.bytes_in, buf.size());
+            const auto n_written = buffer_copy(unref(_sink), buf);
+            detail::pipeline_stage_counters::add(ctr.bytes_out, n_written);
+            const bool last = chunk->last;
+            in.release(chunk);
+            if (n_written != buf.size()) {
+                // The sink is full, and no more data can be written
+                st.sink_full = true;
+                st.abort();
+                return;
+            }
+            if (last) {
+                return;
+            }
+        }
+    }
+
+    void _run_stage(run_state& st, std::size_t idx) {
+        try {
+            if (idx == 0) {
+                _run_source(st);
+            } else if (idx == stage_count - 1) {
+                _run_sink(st);
+            } else {
+                _run_transform_at(st, idx, std::index_sequence_for<Transforms...>{});
+            }
+        } catch (...) {
+            st.fail(std::current_exception());
+        }
+    }
+
+    template <std::size_t... Is>
+    void _run_transform_at(run_state& st, std::size_t idx, std::index_sequence<Is...>) {
+        ((Is + 1 == idx
+              ? _run_transform(unref(std::get<Is>(_transforms)),
+                               *st.links[Is],
+                               *st.links[Is + 1],
+                               _counters[Is + 1])
+              : void()),
+         ...);
+    }
+
+    buffer_pipeline_result _finish(run_state& st) {
+        if (st.error) {
+            std::rethrow_exception(st.error);
+        }
+        return {_counters.back().bytes_out.load(std::memory_order_relaxed), st.sink_full};
+    }
+
+    void _prepare(run_state& st) {
+        neo_assert(expects,
+                   _opts.chunk_size != 0 && _opts.queue_depth != 0,
+                   "buffer_pipeline chunk size and queue depth must be non-zero",
+                   _opts.chunk_size,
+                   _opts.queue_depth);
+        for (auto& c : _counters) {
+            c.reset();
+        }
+        for (std::size_t i = 0; i + 1 < stage_count; ++i) {
+            st.links.push_back(
+                std::make_unique<detail::pipeline_link>(_opts.queue_depth, _opts.chunk_size));
+        }
+    }
+
+public:
+    explicit buffer_pipeline(Source&& src, Sink&& sink, Transforms&&... trs)
+        : _source(NEO_FWD(src))
+        , _sink(NEO_FWD(sink))
+        , _transforms(NEO_FWD(trs)...) {}
+
+    explicit buffer_pipeline(buffer_pipeline_options opts,
+                             Source&&                src,
+                             Sink&&                  sink,
+                             Transforms&&... trs)
+        : _source(NEO_FWD(src))
+        , _sink(NEO_FWD(sink))
+        , _transforms(NEO_FWD(trs)...)
+        , _opts(opts) {}
+
+    NEO_DECL_UNREF_GETTER(source, _source);
+    NEO_DECL_UNREF_GETTER(sink, _sink);
+
+    [[nodiscard]] const buffer_pipeline_options& options() const noexcept { return _opts; }
+
+    /**
+     * Run the pipeline to completion, with each stage on its own thread.
+     * Returns once the source is exhausted and every byte has been written to
+     * the sink, or once the sink stops accepting bytes (see
+     * `buffer_pipeline_result::sink_full`). If any stage throws, the pipeline
+     * is stopped and the exception is rethrown.
+     */
+    buffer_pipeline_result run() {
+        run_state st;
+        _prepare(st);
+        std::vector<std::thread> threads;
+        try {
+            threads.reserve(stage_count - 1);
+            for (std::size_t i = 1; i < stage_count; ++i) {
+                threads.emplace_back([this, &st, i] { _run_stage(st, i); });
+            }
+        } catch (...) {
+            // The stages that did start are using `st`: Stop them before it goes away
+            st.abort();
+            for (auto& t : threads) {
+                t.join();
+            }
+            throw;
+        }
+        _run_stage(st, 0);
+        for (auto& t : threads) {
+            t.join();
+        }
+        return _finish(st);
+    }
+
+    /**
+     * Run the pipeline to completion, with each stage submitted as a task to
+     * `exec`, which is called with a `std::function<void()>`. Since stages
+     * block on one another, the executor must be able to run all of the
+     * stages at the same time.
+     *
+     * If `exec` throws, the task that it was given is taken to have not been
+     * submitted. The stages that were submitted are stopped and waited for, and
+     * the exception is rethrown.
+     */
+    template <typename Executor>
+    buffer_pipeline_result run(Executor&& exec) {
+        run_state               st;
+        std::mutex              finished_mutex;
+        std::condition_variable finished_cv;
+        std::size_t             n_running = stage_count;
+        _prepare(st);
+        std::size_t n_submitted = 0;
+        try {
+            for (; n_submitted < stage_count; ++n_submitted) {
+                exec(std::function<void()>([&, i = n_submitted] {
+                    _run_stage(st, i);
+                    // Notify with the lock held, since the waiter destroys the
+                    // condition variable as soon as it sees the last stage finish
+                    std::lock_guard lk{finished_mutex};
+                    --n_running;
+                    finished_cv.notify_all();
+                }));
+            }
+        } catch (...) {
+            st.abort();
+            std::unique_lock lk{finished_mutex};
+            n_running -= stage_count - n_submitted;
+            finished_cv.wait(lk, [&] { return n_running == 0; });
+            throw;
+        }
+        std::unique_lock lk{finished_mutex};
+        finished_cv.wait(lk, [&] { return n_running == 0; });
+        return _finish(st);
+    }
+
+    /**
+     * Obtain a snapshot of the counters of every stage, in pipeline order: The
+     * source, each transformer, and then the sink.
+     */
+    [[nodiscard]] std::array<buffer_pipeline_stage_stats, stage_count> stats() const noexcept {
+        std::array<buffer_pipeline_stage_stats, stage_count> ret;
+        for (std::size_t i = 0; i < stage_count; ++i) {
+            ret[i] = _counters[i].snapshot();
+        }
+        return ret;
+    }
+};
+
+template <typename Src, typename Sink, typename... Trs>
+explicit buffer_pipeline(Src&&, Sink&&, Trs&&...) -> buffer_pipeline<Src, Sink, Trs...>;
+
+template <typename Src, typename Sink, typename... Trs>
+explicit buffer_pipeline(buffer_pipeline_options, Src&&, Sink&&, Trs&&...)
+    -> buffer_pipeline<Src, Sink, Trs...>;
+
+/**
+ * Run `src` through the transformers `trs` into `sink`, with every stage on its
+ * own thread. Returns the final counters of each stage. (Use
+ * `buffer_pipeline::run()` to learn whether the sink filled up.)
+ */
+template <typename Source, typename Sink, typename... Transforms>
+auto run_buffer_pipeline(Source&& src, Sink&& sink, Transforms&&... trs) {
+    buffer_pipeline pl{NEO_FWD(src), NEO_FWD(sink), NEO_FWD(trs)...};
+    pl.run();
+    return pl.stats();
+}
+
+}  // namespace neo
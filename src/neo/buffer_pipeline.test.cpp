@@ -0,0 +1,228 @@
+#include <neo/buffer_pipeline.hpp>
+
+#include <neo/buffers_consumer.hpp>
+#include <neo/string_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cctype>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::string make_text(std::size_t size) {
+    std::string ret;
+    for (std::size_t i = 0; ret.size() < size; ++i) {
+        ret += "line " + std::to_string(i) + " of the input text\n";
+    }
+    ret.resize(size);
+    return ret;
+}
+
+struct upper_transformer {
+    neo::simple_transform_result operator()(neo::mutable_buffer out, neo::const_buffer in) const {
+        auto n = (std::min)(out.size(), in.size());
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = std::byte(std::toupper(std::to_integer<int>(in[i])));
+        }
+        return {n, n, false};
+    }
+};
+
+/// Writes every byte twice, so may be unable to write a whole input byte
+struct doubling_transformer {
+    bool pending = false;
+    char pending_char;
+
+    neo::simple_transform_result operator()(neo::mutable_buffer out, neo::const_buffer in) {
+        neo::simple_transform_result res;
+        while (out.size() != res.bytes_written) {
+            if (pending) {
+                out[res.bytes_written++] = std::byte(pending_char);
+                pending                  = false;
+            } else if (res.bytes_read != in.size()) {
+                pending_char             = char(in[res.bytes_read++]);
+                out[res.bytes_written++] = std::byte(pending_char);
+                pending                  = true;
+            } else {
+                break;
+            }
+        }
+        return res;
+    }
+};
+
+/// Emits the number of input bytes once the input ends
+struct counting_transformer {
+    std::size_t count   = 0;
+    bool        flushed = false;
+
+    neo::simple_transform_result operator()(neo::mutable_buffer out, neo::const_buffer in) {
+        count += in.size();
+        if (in.size() != 0 || flushed) {
+            return {0, in.size(), false};
+        }
+        auto str = std::to_string(count);
+        neo::buffer_copy(out, neo::as_buffer(str));
+        flushed = true;
+        return {str.size(), 0, false};
+    }
+};
+
+/// Yields at most a few bytes from each call to next()
+struct trickle_source {
+    neo::buffers_consumer<neo::const_buffer> inner;
+
+    neo::const_buffer next(std::size_t n) { return inner.next((std::min)(n, std::size_t(7))); }
+    void              consume(std::size_t n) noexcept { inner.consume(n); }
+};
+
+/// Accepts at most `limit` bytes
+struct limited_sink {
+    std::string str;
+    std::size_t limit;
+    std::size_t size = 0;
+
+    neo::mutable_buffer prepare(std::size_t n) {
+        str.resize((std::min)(size + n, limit));
+        return neo::as_buffer(str) + size;
+    }
+    void commit(std::size_t n) noexcept {
+        size += n;
+        str.resize(size);
+    }
+};
+
+struct throwing_transformer {
+    neo::simple_transform_result operator()(neo::mutable_buffer, neo::const_buffer in) const {
+        if (in.size() != 0) {
+            throw std::runtime_error("Transform failed");
+        }
+        return {};
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Run a pipeline of transformers") {
+    auto text = make_text(1024 * 1024 + 17);
+
+    neo::string_dynbuf_io out;
+    auto stats = neo::run_buffer_pipeline(neo::buffers_consumer(neo::as_buffer(text)),
+                                          out,
+                                          upper_transformer(),
+                                          neo::buffer_copy_transformer(),
+                                          doubling_transformer());
+    static_assert(stats.size() == 5);
+
+    std::string expect;
+    for (auto c : text) {
+        expect.push_back(char(std::toupper(c)));
+        expect.push_back(char(std::toupper(c)));
+    }
+    CHECK(out.read_area_view() == expect);
+
+    CHECK(stats[0].bytes_out == text.size());
+    CHECK(stats[1].bytes_in == text.size());
+    CHECK(stats[3].bytes_out == expect.size());
+    CHECK(stats[4].bytes_out == expect.size());
+}
+
+TEST_CASE("Transformers are flushed at the end of the input") {
+    auto text = make_text(300'000);
+
+    neo::buffer_pipeline_options opts;
+    opts.chunk_size  = 1000;
+    opts.queue_depth = 2;
+
+    neo::string_dynbuf_io out;
+    neo::buffer_pipeline  pl{opts,
+                            neo::buffers_consumer(neo::as_buffer(text)),
+                            out,
+                            counting_transformer()};
+    pl.run();
+    CHECK(out.read_area_view() == std::to_string(text.size()));
+    CHECK(pl.stats()[1].bytes_in == text.size());
+}
+
+TEST_CASE("Run a pipeline on an executor") {
+    auto text = make_text(100'000);
+
+    std::vector<std::thread> pool;
+    auto exec = [&](std::function<void()> fn) { pool.emplace_back(std::move(fn)); };
+
+    neo::string_dynbuf_io out;
+    neo::buffer_pipeline  pl{neo::buffers_consumer(neo::as_buffer(text)), out, upper_transformer()};
+    pl.run(exec);
+    for (auto& t : pool) {
+        t.join();
+    }
+    CHECK(out.available() == text.size());
+    CHECK(std::isupper(out.read_area_view()[0]));
+}
+
+TEST_CASE("An executor that fails to submit a stage stops the submitted ones") {
+    auto text = make_text(100'000);
+
+    std::vector<std::thread> pool;
+    auto                     exec = [&](std::function<void()> fn) {
+        if (pool.size() == 2) {
+            throw std::runtime_error("Executor is full");
+        }
+        pool.emplace_back(std::move(fn));
+    };
+
+    neo::string_dynbuf_io out;
+    neo::buffer_pipeline  pl{neo::buffers_consumer(neo::as_buffer(text)), out, upper_transformer()};
+    CHECK_THROWS_AS(pl.run(exec), std::runtime_error);
+    for (auto& t : pool) {
+        t.join();
+    }
+    CHECK(pool.size() == 2);
+}
+
+TEST_CASE("An exception stops the pipeline") {
+    auto text = make_text(1024 * 1024);
+
+    neo::buffer_pipeline_options opts;
+    opts.chunk_size = 1024;
+
+    neo::string_dynbuf_io out;
+    neo::buffer_pipeline  pl{opts,
+                            neo::buffers_consumer(neo::as_buffer(text)),
+                            out,
+                            upper_transformer(),
+                            throwing_transformer()};
+    CHECK_THROWS_AS(pl.run(), std::runtime_error);
+    CHECK(out.available() == 0);
+}
+
+TEST_CASE("A short read from the source is not the end of the input") {
+    auto text = make_text(100'000);
+
+    neo::string_dynbuf_io out;
+    neo::buffer_pipeline  pl{trickle_source{neo::buffers_consumer(neo::const_buffer(neo::as_buffer(text)))},
+                            out,
+                            upper_transformer()};
+    auto res = pl.run();
+    CHECK(res.bytes_written == text.size());
+    CHECK_FALSE(res.sink_full);
+    CHECK(out.available() == text.size());
+}
+
+TEST_CASE("A full sink is reported") {
+    auto text = make_text(100'000);
+
+    neo::buffer_pipeline_options opts;
+    opts.chunk_size = 1000;
+
+    limited_sink         out{{}, 2500};
+    neo::buffer_pipeline pl{opts, neo::buffers_consumer(neo::as_buffer(text)), out};
+    auto                 res = pl.run();
+    CHECK(res.sink_full);
+    CHECK(res.bytes_written == 2500);
+    CHECK(out.str == text.substr(0, 2500));
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffer_algorithm/size.hpp>
+#include <neo/buffer_range.hpp>
+#include <neo/detail/byte_segment_range.hpp>
+
+#include <neo/assert.hpp>
+#include <neo/fwd.hpp>
+#include <neo/ref_member.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace neo {
+
+/**
+ * A lazy view of a contiguous run of bytes within a buffer range. The first
+ * and last buffers of the run are trimmed as they are iterated, so creating
+ * the view does not copy or allocate, regardless of how many buffers it spans.
+ *
+ * Creating the view walks the underlying buffers up to the end of the slice
+ * (or only to its beginning, if the range is a `sized_buffer_range`). The view
+ * records its own size, and so models `sized_buffer_range`.
+ *
+ * If `Range` is a reference, the referred-to range must not be modified while
+ * the view is in use. If the view owns its range, the starting buffer is
+ * located by buffer index so that the view can be safely copied and moved.
+ */
+template <buffer_range Range>
+class buffer_slice_view {
+public:
+    using range_type = std::remove_cvref_t<Range>;
+
+private:
+    using inner_iter_type = decltype(std::begin(std::declval<const range_type&>()));
+    using segments_type   = detail::byte_segment_range<inner_iter_type>;
+
+    constexpr static bool _caches_iterator = std::is_lvalue_reference_v<Range>;
+
+    [[no_unique_address]] wrap_ref_member_t<Range> _range;
+
+    /// The iterator to the first buffer of the slice, or the index of that buffer
+    std::conditional_t<_caches_iterator, inner_iter_type, std::size_t> _start{};
+    /// The offset within the first buffer at which the slice begins
+    std::size_t _offset = 0;
+    /// The number of bytes in the slice
+    std::size_t _size = 0;
+
+    constexpr inner_iter_type _first() const noexcept {
+        if constexpr (_caches_iterator) {
+            return _start;
+        } else {
+            return std::ranges::next(std::begin(range()), static_cast<std::ptrdiff_t>(_start));
+        }
+    }
+
+public:
+    using buffer_type = typename segments_type::buffer_type;
+    using iterator    = typename segments_type::iterator;
+
+    constexpr buffer_slice_view() = default;
+
+    constexpr buffer_slice_view(Range&& rng, std::size_t offset, std::size_t length) noexcept
+        : _range(NEO_FWD(rng)) {
+        const auto& bufs      = range();
+        auto        it        = std::begin(bufs);
+        const auto  stop      = std::end(bufs);
+        const auto  given_off = offset;
+        std::size_t n_skipped = 0;
+        // Skip the buffers that lie entirely before the slice
+        while (it != stop) {
+            const auto buf_size = as_buffer(*it).size();
+            if (offset < buf_size) {
+                break;
+            }
+            offset -= buf_size;
+            ++it;
+            ++n_skipped;
+        }
+        neo_assert(expects,
+                   it != stop || offset == 0,
+                   "buffer_slice() offset is beyond the end of the buffer range",
+                   given_off,
+                   buffer_size(bufs));
+        if constexpr (_caches_iterator) {
+            _start = it;
+        } else {
+            _start = n_skipped;
+        }
+        _offset = offset;
+        // Clamp the length to the number of bytes that are available
+        if constexpr (sized_buffer_range<range_type>) {
+            _size = (std::min)(length, buffer_size(bufs) - given_off);
+        } else {
+            std::size_t avail = 0;
+            for (; it != stop && avail < length; ++it) {
+                avail += as_buffer(*it).size() - offset;
+                offset = 0;
+            }
+            _size = (std::min)(length, avail);
+        }
+    }
+
+    NEO_DECL_UNREF_GETTER(range, _range);
+
+    [[nodiscard]] constexpr std::size_t byte_size() const noexcept { return _size; }
+
+    constexpr iterator begin() const noexcept { return iterator(_first(), _offset, _size); }
+    constexpr auto     end() const noexcept { return detail::byte_segment_sentinel(); }
+};
+
+template <typename Range>
+buffer_slice_view(Range&&, std::size_t, std::size_t) -> buffer_slice_view<Range>;
+
+/**
+ * Obtain a view of `length` bytes of the given buffer range, beginning at
+ * `offset`. If fewer than `length` bytes are available, the slice ends at the
+ * end of the buffer range.
+ *
+ * Slicing a single buffer returns a buffer. Slicing any other buffer range
+ * returns a `buffer_slice_view`, which will own the range if it is an rvalue.
+ */
+template <buffer_range Range>
+[[nodiscard]] constexpr auto
+buffer_slice(Range&&     rng,
+             std::size_t offset,
+             std::size_t length = std::numeric_limits<std::size_t>::max()) noexcept {
+    if constexpr (single_buffer<std::remove_cvref_t<Range>>) {
+        auto buf = as_buffer(rng);
+        neo_assert(expects,
+                   offset <= buf.size(),
+                   "buffer_slice() offset is beyond the end of the buffer",
+                   offset,
+                   buf.size());
+        return as_buffer(buf + offset, length);
+    } else {
+        return buffer_slice_view<Range>(NEO_FWD(rng), offset, length);
+    }
+}
+
+}  // namespace neo
@@ -0,0 +1,126 @@
+#include <neo/buffer_slice.hpp>
+
+#include <neo/buffer_algorithm.hpp>
+#include <neo/buffers_cat.hpp>
+#include <neo/buffers_consumer.hpp>
+#include <neo/bytewise_index.hpp>
+#include <neo/bytewise_iterator.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std::literals;
+
+NEO_TEST_CONCEPT(neo::buffer_range<neo::buffer_slice_view<std::vector<neo::const_buffer>&>>);
+NEO_TEST_CONCEPT(
+    neo::mutable_buffer_range<neo::buffer_slice_view<std::vector<neo::mutable_buffer>&>>);
+NEO_TEST_CONCEPT(neo::sized_buffer_range<neo::buffer_slice_view<std::vector<neo::const_buffer>>>);
+
+namespace {
+
+template <typename Bufs>
+std::string slice_string(const Bufs& bufs) {
+    std::string ret;
+    ret.resize(neo::buffer_size(bufs));
+    neo::buffer_copy(neo::as_buffer(ret), bufs);
+    return ret;
+}
+
+}  // namespace
+
+TEST_CASE("Slice a single buffer") {
+    auto buf   = neo::const_buffer("Hello, world!");
+    auto slice = neo::buffer_slice(buf, 7, 5);
+    CHECK(slice.equals_string("world"sv));
+    CHECK(neo::buffer_slice(buf, 7).equals_string("world!"sv));
+    CHECK(neo::buffer_slice(buf, 13).empty());
+}
+
+TEST_CASE("Slice a multi-buffer range") {
+    std::vector<neo::const_buffer> bufs = {
+        neo::const_buffer("The quick "),
+        neo::const_buffer(""),
+        neo::const_buffer("brown fox "),
+        neo::const_buffer("jumps"),
+    };
+
+    auto slice = neo::buffer_slice(bufs, 4, 11);
+    CHECK(neo::buffer_size(slice) == 11);
+    CHECK(neo::buffer_count(slice) == 2);
+    CHECK(slice_string(slice) == "quick brown");
+
+    // Slices that begin or end exactly on buffer boundaries
+    CHECK(slice_string(neo::buffer_slice(bufs, 10, 10)) == "brown fox ");
+    CHECK(neo::buffer_count(neo::buffer_slice(bufs, 10, 10)) == 1);
+    CHECK(slice_string(neo::buffer_slice(bufs, 0)) == "The quick brown fox jumps");
+
+    // The length is clamped to what is available
+    CHECK(slice_string(neo::buffer_slice(bufs, 20, 1000)) == "jumps");
+    CHECK(neo::buffer_is_empty(neo::buffer_slice(bufs, 25)));
+
+    // Slices of slices
+    CHECK(slice_string(neo::buffer_slice(slice, 6, 3)) == "bro");
+}
+
+TEST_CASE("Slice an owned range") {
+    auto slice = neo::buffer_slice(std::vector<neo::const_buffer>{neo::const_buffer("abc"),
+                                                                  neo::const_buffer("def"),
+                                                                  neo::const_buffer("ghi")},
+                                   4,
+                                   4);
+    auto copy = slice;
+    CHECK(slice_string(copy) == "efgh");
+    auto moved = std::move(copy);
+    CHECK(slice_string(moved) == "efgh");
+}
+
+TEST_CASE("Slice a buffer concatenation") {
+    std::string first  = "0123456789";
+    std::string second = "abcdefghij";
+    std::string third  = "ABCDEFGHIJ";
+    auto cat
+        = neo::buffers_cat(neo::as_buffer(first), neo::as_buffer(second), neo::as_buffer(third));
+
+    auto slice = neo::buffer_slice(cat, 5, 20);
+    CHECK(slice_string(slice) == "56789abcdefghijABCDE");
+
+    // A slice can be fed to a buffers_consumer
+    neo::buffers_consumer cons{slice};
+    cons.consume(7);
+    CHECK(std::string_view(reinterpret_cast<const char*>(cons.next(100).data()),
+                           cons.next(100).size())
+          == "cdefghij");
+
+    // ... and iterated bytewise
+    neo::bytewise_iterator it{slice};
+    CHECK(std::distance(it, it.end()) == 20);
+    CHECK(*it == std::byte{'5'});
+
+    // And concatenated again
+    auto cat2 = neo::buffers_cat(slice, neo::const_buffer("!"));
+    CHECK(slice_string(cat2) == "56789abcdefghijABCDE!");
+
+    // Mutable slices may be written through
+    neo::buffer_copy(neo::buffer_slice(cat, 8, 4), neo::const_buffer("----"));
+    CHECK(first == "01234567--");
+    CHECK(second == "--cdefghij");
+}
+
+TEST_CASE("Slice an indexed range") {
+    std::vector<neo::const_buffer> bufs = {
+        neo::const_buffer("The quick "),
+        neo::const_buffer("brown fox "),
+        neo::const_buffer("jumps"),
+    };
+    neo::bytewise_index idx{bufs};
+
+    auto slice = idx.slice(16, 6);
+    CHECK(neo::buffer_size(slice) == 6);
+    CHECK(slice_string(slice) == "fox ju");
+    CHECK(slice_string(idx.slice(20)) == "jumps");
+    CHECK(neo::buffer_is_empty(idx.slice(25)));
+}
@@ -22,6 +22,22 @@ concept buffer_source =
     };
 // clang-format on
 
+/**
+ * A "rewindable_buffer_source" is a buffer_source that can save its read
+ * position with `mark()`, return to a saved position with `rewind()`, and
+ * discard a saved position with `release()`. Bytes consumed after a mark remain
+ * readable until the mark is released.
+ */
+// clang-format off
+template <typename T>
+concept rewindable_buffer_source =
+    buffer_source<T> &&
+    requires (T source, const decltype(source.mark())& mark) {
+        { source.rewind(mark) } noexcept;
+        { source.release(mark) } noexcept;
+    };
+// clang-format on
+
 struct proto_buffer_source {
     proto_buffer_source() = delete;
 
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <neo/buffer_range.hpp>
+#include <neo/buffers_cat.hpp>
+
+#include <neo/assert.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <tuple>
+
+namespace neo {
+
+/**
+ * A `buffer_vector` is a growable array of buffers. The first `InlineCount`
+ * buffers are stored inline in the object, and longer sequences spill into
+ * storage obtained from `Allocator`. A pool or arena can be used for the
+ * spilled storage via `pmr::buffer_vector`.
+ *
+ * Iterators are plain pointers, so walking the sequence is a linear scan with
+ * no per-step dispatch, regardless of how the buffers were produced. Unlike
+ * `static_buffer_vector`, there is no upper bound on the number of buffers.
+ *
+ * This models `buffer_range` and conditionally `mutable_buffer_range` (if
+ * `BufferType` is mutable_buffer). The total byte size is tracked as buffers
+ * are appended, so this also models `sized_buffer_range`. For that reason,
+ * the stored buffers cannot be modified in-place.
+ */
+template <typename BufferType,
+          std::size_t InlineCount = 16,
+          typename Allocator      = std::allocator<BufferType>>
+class buffer_vector {
+public:
+    using value_type     = BufferType;
+    using buffer_type    = value_type;
+    using allocator_type = Allocator;
+
+    using const_pointer   = const buffer_type*;
+    using const_reference = const buffer_type&;
+    using iterator        = const_pointer;
+    using const_iterator  = const_pointer;
+
+private:
+    using alloc_traits = std::allocator_traits<allocator_type>;
+
+    /// Heap storage, or `nullptr` while the buffers still fit inline
+    buffer_type* _heap     = nullptr;
+    std::size_t  _count    = 0;
+    std::size_t  _capacity = InlineCount;
+    std::size_t  _bytes    = 0;
+
+    [[no_unique_address]] allocator_type _alloc;
+
+    buffer_type _inline[InlineCount == 0 ? 1 : InlineCount];
+
+    constexpr buffer_type*       _data() noexcept { return _heap ? _heap : _inline; }
+    constexpr const buffer_type* _data() const noexcept { return _heap ? _heap : _inline; }
+
+    constexpr void _release() noexcept {
+        if (_heap) {
+            alloc_traits::deallocate(_alloc, _heap, _capacity);
+            _heap = nullptr;
+        }
+        _capacity = InlineCount;
+    }
+
+    template <typename Other>
+    constexpr void _copy_from(const Other& other) {
+        reserve(other.size());
+        auto out = _data();
+        for (auto&& buf : other) {
+            *out++ = buf;
+        }
+        _count = other.size();
+        _bytes = buffer_size(other);
+    }
+
+public:
+    constexpr buffer_vector() noexcept = default;
+
+    constexpr explicit buffer_vector(const allocator_type& alloc) noexcept
+        : _alloc(alloc) {}
+
+    /**
+     * Construct a buffer_vector from the non-empty buffers in the given buffer range.
+     */
+    template <buffer_range Bufs>
+    requires(!alike<Bufs, buffer_vector>)  //
+        constexpr explicit buffer_vector(const Bufs&           bufs,
+                                         const allocator_type& alloc = allocator_type())
+        : _alloc(alloc) {
+        append(bufs);
+    }
+
+    constexpr buffer_vector(const buffer_vector& other)
+        : _alloc(alloc_traits::select_on_container_copy_construction(other._alloc)) {
+        _copy_from(other);
+    }
+
+    constexpr buffer_vector(buffer_vector&& other) noexcept
+        : _alloc(other._alloc) {
+        if (other._heap) {
+            // Steal the heap storage
+            _heap           = other._heap;
+            _capacity       = other._capacity;
+            _count          = other._count;
+            _bytes          = other._bytes;
+            other._heap     = nullptr;
+            other._capacity = InlineCount;
+        } else {
+            _copy_from(other);
+        }
+        other.clear();
+    }
+
+    constexpr buffer_vector& operator=(const buffer_vector& other) {
+        if (this != &other) {
+            clear();
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                // Storage from our current allocator must be freed by it
+                if (_alloc != other._alloc) {
+                    _release();
+                }
+                _alloc = other._alloc;
+            }
+            _copy_from(other);
+        }
+        return *this;
+    }
+
+    /**
+     * Move-assign from another buffer_vector. If the allocator does not
+     * propagate and the two allocators compare unequal, the other's heap
+     * storage cannot be taken, and the buffers are copied instead (which may
+     * allocate and throw).
+     */
+    constexpr buffer_vector& operator=(buffer_vector&& other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value
+        || alloc_traits::is_always_equal::value) {
+        if (this != &other) {
+            _release();
+            clear();
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                _alloc = other._alloc;
+            }
+            // We can only take the other's storage if we are able to free it
+            if (other._heap && _alloc == other._alloc) {
+                _heap           = other._heap;
+                _capacity       = other._capacity;
+                _count          = other._count;
+                _bytes          = other._bytes;
+                other._heap     = nullptr;
+                other._capacity = InlineCount;
+            } else {
+                _copy_from(other);
+            }
+            other.clear();
+        }
+        return *this;
+    }
+
+    constexpr ~buffer_vector() { _release(); }
+
+    /// The number of buffers in the sequence
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return _count; }
+    /// The number of buffers that can be stored without reallocating
+    [[nodiscard]] constexpr std::size_t capacity() const noexcept { return _capacity; }
+    /// The largest number of buffers that can be stored
+    [[nodiscard]] constexpr std::size_t max_size() const noexcept {
+        return alloc_traits::max_size(_alloc);
+    }
+    /// The total number of bytes viewed by the buffers in the sequence
+    [[nodiscard]] constexpr std::size_t byte_size() const noexcept { return _bytes; }
+    /// Whether the sequence contains no buffers
+    [[nodiscard]] constexpr bool empty() const noexcept { return _count == 0; }
+    /// Whether the buffers are still held in the inline storage
+    [[nodiscard]] constexpr bool is_inline() const noexcept { return _heap == nullptr; }
+
+    [[nodiscard]] constexpr allocator_type get_allocator() const noexcept { return _alloc; }
+
+    constexpr const_iterator cbegin() const noexcept { return _data(); }
+    constexpr const_iterator begin() const noexcept { return cbegin(); }
+    constexpr const_iterator cend() const noexcept { return cbegin() + _count; }
+    constexpr const_iterator end() const noexcept { return cend(); }
+
+    constexpr const_reference operator[](std::size_t idx) const noexcept {
+        neo_assert(expects, idx < size(), "Index out-of-range", idx, size());
+        return _data()[idx];
+    }
+
+    /**
+     * Ensure there is room for at least `n` buffers without reallocating.
+     */
+    constexpr void reserve(std::size_t n) {
+        if (n <= _capacity) {
+            return;
+        }
+        // Grow geometrically to keep repeated push_back() amortized-constant
+        auto new_cap = (std::max)(n, _capacity * 2);
+        auto new_buf = alloc_traits::allocate(_alloc, new_cap);
+        auto out     = new_buf;
+        for (auto it = begin(); it != end(); ++it) {
+            *out++ = *it;
+        }
+        _release();
+        _heap     = new_buf;
+        _capacity = new_cap;
+    }
+
+    /**
+     * Append a single buffer to the end of the sequence.
+     */
+    constexpr void push_back(buffer_type b) {
+        if (_count == _capacity) {
+            reserve(_count + 1);
+        }
+        _data()[_count] = b;
+        ++_count;
+        _bytes += b.size();
+    }
+
+    /**
+     * Append the non-empty buffers from the given buffer range.
+     */
+    template <buffer_range Bufs>
+    constexpr void append(const Bufs& bufs) {
+        for (auto&& buf : bufs) {
+            buffer_type b = buf;
+            if (!b.empty()) {
+                push_back(b);
+            }
+        }
+    }
+
+    /**
+     * Append the non-empty buffers of each part of a buffers_seq_concat. The
+     * parts are walked directly, bypassing the concatenation iterator.
+     */
+    template <typename... Bufs>
+    constexpr void append(const buffers_seq_concat<Bufs...>& cat) {
+        std::apply([&](auto&&... parts) { (append(parts), ...); }, cat.tuple());
+    }
+
+    /**
+     * Remove all buffers from the sequence. Does not release heap storage.
+     */
+    constexpr void clear() noexcept {
+        _count = 0;
+        _bytes = 0;
+    }
+};
+
+namespace pmr {
+
+/**
+ * A buffer_vector that obtains its spilled storage from a std::pmr::memory_resource
+ */
+template <typename BufferType, std::size_t InlineCount = 16>
+using buffer_vector
+    = neo::buffer_vector<BufferType, InlineCount, std::pmr::polymorphic_allocator<BufferType>>;
+
+}  // namespace pmr
+
+}  // namespace neo
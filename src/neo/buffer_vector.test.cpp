@@ -0,0 +1,62 @@
+#include <neo/buffer_vector.hpp>
+
+#include <neo/buffer_algorithm.hpp>
+#include <neo/const_buffer.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <memory_resource>
+#include <string>
+#include <type_traits>
+
+using namespace std::literals;
+
+NEO_TEST_CONCEPT(neo::buffer_range<neo::buffer_vector<neo::const_buffer>>);
+NEO_TEST_CONCEPT(neo::mutable_buffer_range<neo::buffer_vector<neo::mutable_buffer>>);
+NEO_TEST_CONCEPT(neo::sized_buffer_range<neo::buffer_vector<neo::const_buffer>>);
+NEO_TEST_CONCEPT(neo::buffer_range<neo::pmr::buffer_vector<neo::const_buffer>>);
+
+// Move-assignment can only fall back to a (throwing) copy if allocators may differ
+static_assert(std::is_nothrow_move_assignable_v<neo::buffer_vector<neo::const_buffer>>);
+static_assert(!std::is_nothrow_move_assignable_v<neo::pmr::buffer_vector<neo::const_buffer>>);
+
+TEST_CASE("Grow a buffer_vector beyond its inline capacity") {
+    neo::buffer_vector<neo::const_buffer, 4> vec;
+    for (auto i = 0; i < 100; ++i) {
+        vec.push_back(neo::const_buffer("ab"));
+    }
+    CHECK_FALSE(vec.is_inline());
+    CHECK(vec.size() == 100);
+    CHECK(vec.capacity() >= 100);
+    CHECK(neo::buffer_size(vec) == 200);
+
+    vec.clear();
+    CHECK(vec.empty());
+    CHECK(neo::buffer_size(vec) == 0);
+}
+
+TEST_CASE("Allocate buffer_vector storage from a memory resource") {
+    std::byte                           arena[4096];
+    std::pmr::monotonic_buffer_resource mr{arena, sizeof arena, std::pmr::null_memory_resource()};
+
+    neo::pmr::buffer_vector<neo::const_buffer, 2> vec{&mr};
+    vec.push_back(neo::const_buffer("foo"));
+    vec.push_back(neo::const_buffer("bar"));
+    vec.push_back(neo::const_buffer("baz"));
+    CHECK_FALSE(vec.is_inline());
+    CHECK(vec.get_allocator().resource() == &mr);
+
+    std::string out;
+    out.resize(9);
+    neo::buffer_copy(neo::as_buffer(out), vec);
+    CHECK(out == "foobarbaz");
+
+    // Moving into a vector using a different resource copies the buffers
+    neo::pmr::buffer_vector<neo::const_buffer, 2> other;
+    other = std::move(vec);
+    CHECK(other.size() == 3);
+    CHECK(other.get_allocator().resource() != &mr);
+    CHECK(other[2].equals_string("baz"sv));
+}
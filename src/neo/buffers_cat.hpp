@@ -71,7 +71,7 @@ public:
                 _iter_var = total_end{};
             } else {
                 auto&& nth_buffer = std::get<N>(*_bufs);
-                if (buffer_size(nth_buffer) == 0) {
+                if (buffer_is_empty(nth_buffer)) {
                     // The buffer at position N is empty. Skip over it
                     return _become<N + 1>();
                 }
@@ -139,6 +139,16 @@ public:
     constexpr iterator begin() const noexcept { return iterator(_bufs); }
     constexpr iterator end() const noexcept { return iterator(); }
 
+    /**
+     * The total size of the concatenation, available when every inner range is
+     * a sized_buffer_range. This costs one call per part rather than one per
+     * buffer.
+     */
+    constexpr std::size_t byte_size() const noexcept requires(sized_buffer_range<Bufs>&&...) {
+        return std::apply([](auto&&... parts) { return (std::size_t(0) + ... + parts.byte_size()); },
+                          _bufs);
+    }
+
     constexpr const buffer_tuple& tuple() const& noexcept { return _bufs; }
     constexpr buffer_tuple&&      tuple() && noexcept { return std::move(_bufs); }
 };
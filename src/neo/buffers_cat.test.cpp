@@ -6,6 +6,7 @@
 #include <neo/buffer_algorithm/size.hpp>
 #include <neo/buffer_algorithm/transform.hpp>
 #include <neo/platform.hpp>
+#include <neo/static_buffer_vector.hpp>
 #include <neo/string_io.hpp>
 
 #include <neo/test_concept.hpp>
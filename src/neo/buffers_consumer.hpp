@@ -3,11 +3,13 @@
 #include <neo/as_buffer.hpp>
 #include <neo/buffer_algorithm/size.hpp>
 #include <neo/buffer_range.hpp>
-#include <neo/static_buffer_vector.hpp>
+#include <neo/buffer_vector.hpp>
 
 #include <neo/assert.hpp>
 
+#include <algorithm>
 #include <limits>
+#include <utility>
 
 namespace neo {
 
@@ -33,6 +35,18 @@ protected:
 
     std::size_t _cur_elem_offset = 0;
     std::size_t _remaining;
+    std::size_t _n_linearized = 0;
+
+    /// Find the next buffer position at which there are bytes to read
+    constexpr auto _first_nonempty() const noexcept {
+        auto it     = _seq_it;
+        auto offset = _cur_elem_offset;
+        while (it != _seq_stop && as_buffer(*it).size() == offset) {
+            ++it;
+            offset = 0;
+        }
+        return std::pair{it, offset};
+    }
 
 public:
     constexpr buffers_consumer() = default;
@@ -55,13 +69,55 @@ public:
     }
 
     [[nodiscard]] constexpr auto next(std::size_t n) const noexcept {
-        if (_seq_it == _seq_stop) {
+        auto [it, offset] = _first_nonempty();
+        if (it == _seq_stop) {
             return buffer_type();
         }
         n = (std::min)(n, _remaining);
-        return as_buffer(*_seq_it + _cur_elem_offset, n);
+        return as_buffer(*it + offset, n);
+    }
+
+    /**
+     * Obtain the next `n` bytes as a single contiguous buffer, without
+     * consuming them.
+     *
+     * If the bytes lie within a single buffer of the underlying range, a view
+     * of that buffer is returned directly. Otherwise the bytes are copied into
+     * `scratch` and a view of `scratch` is returned. The returned buffer will
+     * be smaller than `n` only if fewer bytes are available, or if `scratch`
+     * is too small to hold them.
+     */
+    [[nodiscard]] constexpr const_buffer peek_contiguous(std::size_t    n,
+                                                         mutable_buffer scratch) noexcept {
+        auto [it, offset] = _first_nonempty();
+        if (it == _seq_stop) {
+            return const_buffer();
+        }
+        n                = (std::min)(n, _remaining);
+        const_buffer buf = as_buffer(*it + offset, n);
+        if (buf.size() == n || scratch.size() <= buf.size()) {
+            // The bytes are already contiguous, or we cannot do any better
+            return buf;
+        }
+        // The bytes span multiple buffers. Copy them into the scratch space.
+        ++_n_linearized;
+        n                    = (std::min)(n, scratch.size());
+        std::size_t n_copied = 0;
+        for (; it != _seq_stop && n_copied != n; ++it) {
+            buf = as_buffer(*it + offset, n - n_copied);
+            std::copy_n(buf.data(), buf.size(), scratch.data() + n_copied);
+            n_copied += buf.size();
+            offset = 0;
+        }
+        return const_buffer(scratch.data(), n_copied);
     }
 
+    /**
+     * The number of times that peek_contiguous() had to copy bytes into its
+     * scratch space.
+     */
+    [[nodiscard]] constexpr std::size_t linearized_count() const noexcept { return _n_linearized; }
+
     constexpr void consume(std::size_t size) noexcept {
         const auto consume_size = size;
         neo_assert(expects,
@@ -93,6 +149,46 @@ public:
     constexpr void commit(std::size_t size) noexcept requires(mutable_buffer_range<BaseRange>) {
         consume(size);
     }
+
+    /**
+     * A saved position of a buffers_consumer. See mark() and rewind().
+     */
+    struct mark_type {
+        inner_buffer_iterator seq_it;
+        std::size_t           elem_offset;
+        std::size_t           remaining;
+    };
+
+    /**
+     * Save the current read position. The consumer can later be returned to
+     * that position with rewind(), allowing bytes to be re-read after they are
+     * consumed. Nothing is copied.
+     */
+    [[nodiscard]] constexpr mark_type mark() const noexcept {
+        return mark_type{_seq_it, _cur_elem_offset, _remaining};
+    }
+
+    /**
+     * Return to a position previously saved with mark(). The mark remains
+     * valid and may be rewound-to again.
+     */
+    constexpr void rewind(const mark_type& m) noexcept {
+        neo_assert(expects,
+                   m.remaining >= _remaining,
+                   "Cannot rewind a buffers_consumer to a position ahead of its current position",
+                   m.remaining,
+                   _remaining);
+        _seq_it          = m.seq_it;
+        _cur_elem_offset = m.elem_offset;
+        _remaining       = m.remaining;
+    }
+
+    /**
+     * Discard a mark. This is a no-op for a buffers_consumer, since consumed
+     * bytes are never released, but is provided for parity with other
+     * rewindable sources.
+     */
+    constexpr void release(const mark_type&) noexcept {}
 };
 
 template <single_buffer T>
@@ -116,10 +212,30 @@ public:
     }
     [[nodiscard]] constexpr auto next(std::size_t n) const noexcept { return as_buffer(_buf, n); }
 
+    [[nodiscard]] constexpr const_buffer peek_contiguous(std::size_t n, mutable_buffer) noexcept {
+        return as_buffer(_buf, n);
+    }
+    [[nodiscard]] constexpr std::size_t linearized_count() const noexcept { return 0; }
+
     constexpr void consume(std::size_t n) noexcept { _buf += n; }
     constexpr void commit(std::size_t n) noexcept requires(mutable_buffer_range<T>) { consume(n); }
 
     [[nodiscard]] constexpr bool empty() const noexcept { return _buf.empty(); }
+
+    using mark_type = buffer_type;
+
+    [[nodiscard]] constexpr mark_type mark() const noexcept { return _buf; }
+
+    constexpr void rewind(const mark_type& m) noexcept {
+        neo_assert(expects,
+                   m.size() >= _buf.size(),
+                   "Cannot rewind a buffers_consumer to a position ahead of its current position",
+                   m.size(),
+                   _buf.size());
+        _buf = m;
+    }
+
+    constexpr void release(const mark_type&) noexcept {}
 };
 
 template <typename T>
@@ -128,6 +244,12 @@ buffers_consumer(T&&) -> buffers_consumer<T>;
 template <typename T>
 buffers_consumer(T&&, std::size_t) -> buffers_consumer<T>;
 
+/**
+ * A `buffers_vec_consumer` is a `buffers_consumer` whose `next()` returns every
+ * buffer needed to cover the requested number of bytes, rather than only the
+ * first. The buffers are gathered into a `buffer_vector`, which stores up to
+ * 16 buffers inline and allocates beyond that.
+ */
 template <buffer_range BaseRange>
 class buffers_vec_consumer : public buffers_consumer<BaseRange> {
     constexpr static std::size_t _small_size = 16;
@@ -141,10 +263,10 @@ public:
     // just return a single contiguous buffer.
     using buffers_vec_consumer::buffers_consumer::next;
 
-    [[nodiscard]] constexpr auto next(std::size_t n_to_prepare) noexcept
+    [[nodiscard]] constexpr auto next(std::size_t n_to_prepare)
         requires(!single_buffer<BaseRange>) {
-        // Build a small vector of buffers from the whole sequence
-        static_buffer_vector<buffer_type, _small_size> bufs;
+        // Build a vector of buffers from the whole sequence
+        buffer_vector<buffer_type, _small_size> bufs;
         // Keep track of how far into the first buffer we are skipping
         auto elem_offset = this->_cur_elem_offset;
         // Clamp to the max we are allowed to consume
@@ -153,13 +275,14 @@ public:
              // Stop if we reach the end of the base sequence
              it != this->_seq_stop &&
              // Or we have prepared every byte
-             n_to_prepare != 0 &&
-             // Or there is no more room in the temp buffer array
-             bufs.size() < bufs.max_size();
+             n_to_prepare != 0;
              ++it) {
             // Store a buffer element. The first element may need to be offset into, and we may
             // need to clamp it
-            auto buf = bufs.push_back(as_buffer(*it + elem_offset, n_to_prepare));
+            auto buf = as_buffer(*it + elem_offset, n_to_prepare);
+            if (!buf.empty()) {
+                bufs.push_back(buf);
+            }
             // Decrement the max size by the number byte in that buffer
             n_to_prepare -= buf.size();
             // After the first, never advance the buffer.
@@ -168,7 +291,7 @@ public:
         return bufs;
     }
 
-    [[nodiscard]] constexpr auto prepare(std::size_t s) noexcept
+    [[nodiscard]] constexpr auto prepare(std::size_t s)
         requires(mutable_buffer_range<BaseRange>) {
         return next(s);
     }
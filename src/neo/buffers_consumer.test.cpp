@@ -1,11 +1,20 @@
 #include <neo/buffers_consumer.hpp>
 
 #include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffer_source.hpp>
+
+#include <neo/test_concept.hpp>
 
 #include <catch2/catch.hpp>
 
+#include <vector>
+
 using namespace std::literals;
 
+NEO_TEST_CONCEPT(neo::rewindable_buffer_source<neo::buffers_consumer<neo::const_buffer>>);
+NEO_TEST_CONCEPT(
+    neo::rewindable_buffer_source<neo::buffers_consumer<std::vector<neo::const_buffer>&>>);
+
 TEST_CASE("Consume some buffers") {
     auto bufs = {
         neo::const_buffer("meow"),
@@ -85,3 +94,101 @@ TEST_CASE("Consume mutable buffers too") {
     buffer_copy(c.prepare(200), neo::const_buffer("short string"));
     CHECK(a == "short stri");
 }
+
+TEST_CASE("Skip empty buffers in the middle of a sequence") {
+    auto bufs = {
+        neo::const_buffer("meow"),
+        neo::const_buffer(""),
+        neo::const_buffer("bark"),
+    };
+    neo::buffers_consumer cons{bufs};
+    cons.consume(4);
+    CHECK(cons.next(100).equals_string("bark"sv));
+
+    std::string str;
+    str.resize(8);
+    neo::buffers_consumer cons2{bufs};
+    CHECK(buffer_copy(neo::as_buffer(str), cons2) == 8);
+    CHECK(str == "meowbark");
+}
+
+TEST_CASE("Peek contiguous bytes from a buffers_consumer") {
+    auto bufs = {
+        neo::const_buffer("meow"),
+        neo::const_buffer(""),
+        neo::const_buffer("bark"),
+        neo::const_buffer("sing"),
+    };
+    neo::buffers_consumer cons{bufs};
+    std::string           scratch_str;
+    scratch_str.resize(6);
+    auto scratch = neo::as_buffer(scratch_str);
+
+    // Within the first buffer: No copy
+    auto part = cons.peek_contiguous(3, scratch);
+    CHECK(part.equals_string("meo"sv));
+    CHECK(part.data() == std::data(bufs)[0].data());
+    CHECK(cons.linearized_count() == 0);
+
+    // Spanning the boundary: Linearized into the scratch space
+    cons.consume(2);
+    part = cons.peek_contiguous(4, scratch);
+    CHECK(part.equals_string("owba"sv));
+    CHECK(part.data() == scratch.data());
+    CHECK(cons.linearized_count() == 1);
+
+    // Clamped by the size of the scratch space
+    part = cons.peek_contiguous(100, scratch);
+    CHECK(part.equals_string("owbark"sv));
+    CHECK(cons.linearized_count() == 2);
+
+    // Nothing was consumed by peeking
+    CHECK(cons.next(2).equals_string("ow"sv));
+    cons.consume(2);
+    part = cons.peek_contiguous(4, scratch);
+    CHECK(part.equals_string("bark"sv));
+    CHECK(cons.linearized_count() == 2);
+
+    neo::buffers_consumer single{neo::const_buffer("single buffer")};
+    CHECK(single.peek_contiguous(6, scratch).equals_string("single"sv));
+}
+
+TEST_CASE("Rewind a buffers_consumer") {
+    auto bufs = {
+        neo::const_buffer("meow"),
+        neo::const_buffer("bark"),
+    };
+    neo::buffers_consumer cons{bufs};
+    cons.consume(2);
+    auto m = cons.mark();
+    cons.consume(4);
+    CHECK(cons.next(100).equals_string("rk"sv));
+    cons.rewind(m);
+    CHECK(cons.next(100).equals_string("ow"sv));
+    cons.consume(6);
+    CHECK(cons.empty());
+    cons.rewind(m);
+    CHECK_FALSE(cons.empty());
+    cons.release(m);
+
+    neo::buffers_consumer single{neo::const_buffer("single")};
+    auto                  sm = single.mark();
+    single.consume(6);
+    CHECK(single.empty());
+    single.rewind(sm);
+    CHECK(single.next(3).equals_string("sin"sv));
+}
+
+TEST_CASE("Get a long gather list from a buffers_vec_consumer") {
+    std::vector<neo::const_buffer> bufs;
+    for (auto i = 0; i < 40; ++i) {
+        bufs.push_back(neo::const_buffer("abc"));
+    }
+    neo::buffers_vec_consumer cons{bufs};
+    cons.consume(1);
+    auto gather = cons.next(1000);
+    // No truncation at 16 buffers
+    CHECK(gather.size() == 40);
+    CHECK(neo::buffer_size(gather) == 119);
+    CHECK(gather[0].equals_string("bc"sv));
+}
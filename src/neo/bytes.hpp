@@ -2,6 +2,7 @@
 
 #include <neo/buffer_algorithm/copy.hpp>
 #include <neo/buffer_algorithm/size.hpp>
+#include <neo/buffer_copy_accounting.hpp>
 #include <neo/const_buffer.hpp>
 #include <neo/mutable_buffer.hpp>
 
@@ -45,6 +46,8 @@ private:
 private:
     [[no_unique_address]] allocator_type _alloc;
 
+    [[no_unique_address]] detail::buffer_copy_accounting<basic_bytes> _copy_acct;
+
     /**
      * Resize the underlying array of bytes. This method will copy over the old
      * content, but it will not modify any new trailing bytes
@@ -81,6 +84,11 @@ private:
         // Return a pointer to the beginning of the new tail of the buffer if it
         // has grown, otherwise just the pointer to the end.
         const auto minsize = (new_size > old_size) ? old_size : new_size;
+
+        _copy_acct.reallocated();
+        _copy_acct.moved(minsize);
+        _copy_acct.grown(new_size - minsize);
+        _copy_acct.observe(new_size, new_size);
         return data() + minsize;
     }
 
@@ -283,6 +291,7 @@ public:
         for (auto it = tail_ptr; it != stop; ++it) {
             *it = pattern;
         }
+        _copy_acct.filled(static_cast<std::size_t>(stop - tail_ptr));
 
         return tail_ptr;
     }
@@ -292,6 +301,14 @@ public:
      */
     constexpr pointer resize(size_type size, uninit_t) noexcept { return _resize_uninit(size); }
 
+    /**
+     * The work done by this object to resize itself. See
+     * NEO_BUFFER_COPY_ACCOUNTING.
+     */
+    [[nodiscard]] constexpr buffer_copy_stats copy_stats() const noexcept {
+        return _copy_acct.stats();
+    }
+
     [[nodiscard]] constexpr friend bool operator==(const basic_bytes& lhs,
                                                    const_buffer       rhs) noexcept {
         if (lhs.size() != rhs.size()) {
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <neo/buffer_range.hpp>
+#include <neo/byte_array.hpp>
+#include <neo/const_buffer.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace neo {
+
+namespace detail {
+
+/**
+ * The number of bytes contributed by a compile-time constant part given to
+ * bytes_concat(). String literals do not contribute their null terminator.
+ *
+ * Only arrays of `const char` are treated as string literals, and their last
+ * element is checked to be a null terminator. A mutable `char[N]` might not
+ * be null-terminated, so it is not accepted.
+ */
+template <typename T>
+struct static_bytes_extent;
+
+template <typename T>
+struct static_bytes_extent<const T> : static_bytes_extent<T> {};
+
+template <std::size_t N>
+struct static_bytes_extent<byte_array<N>> : std::integral_constant<std::size_t, N> {};
+
+template <std::size_t N>
+struct static_bytes_extent<std::array<std::byte, N>> : std::integral_constant<std::size_t, N> {};
+
+template <std::size_t N>
+struct static_bytes_extent<const char[N]> : std::integral_constant<std::size_t, N - 1> {};
+
+template <typename T>
+constexpr std::size_t static_bytes_extent_v
+    = static_bytes_extent<std::remove_reference_t<T>>::value;
+
+template <typename Part>
+constexpr std::byte* static_bytes_copy(std::byte* out, const Part& part) {
+    constexpr auto part_size = static_bytes_extent_v<const Part>;
+    if constexpr (std::is_array_v<Part>) {
+        // Checked even without assertions, since the last element would otherwise be silently
+        // dropped. In a constant expression, this is a compile error.
+        if (part[part_size] != '\0') {
+            throw std::invalid_argument(
+                "A char array given to bytes_concat() is not a null-terminated string");
+        }
+    }
+    for (std::size_t idx = 0; idx != part_size; ++idx) {
+        *out++ = static_cast<std::byte>(part[idx]);
+    }
+    return out;
+}
+
+constexpr std::uint64_t fnv1a_offset_basis = 0xcbf29ce484222325;
+constexpr std::uint64_t fnv1a_prime        = 0x100000001b3;
+
+constexpr std::uint64_t fnv1a_update(std::uint64_t h, const std::byte* ptr, std::size_t size) {
+    for (; size; --size) {
+        h = (h ^ std::to_integer<std::uint64_t>(*ptr++)) * fnv1a_prime;
+    }
+    return h;
+}
+
+}  // namespace detail
+
+// clang-format off
+/**
+ * A compile-time constant sequence of bytes with a size that is part of its
+ * type: A `byte_array`, a `std::array` of `std::byte`, or a string literal (an
+ * array of `const char`).
+ */
+template <typename T>
+concept static_bytes = requires {
+    detail::static_bytes_extent<std::remove_reference_t<T>>::value;
+};
+// clang-format on
+
+/**
+ * Concatenate the given compile-time byte sequences into a single byte_array.
+ * Unlike `buffers_cat`, the result is one contiguous array that may be
+ * computed entirely at compile-time:
+ *
+ *      constexpr auto preamble = neo::bytes_concat("PRI * HTTP/2.0\r\n", crlf);
+ *
+ * Throws std::invalid_argument if a `const char` array does not end with a
+ * null terminator (which is a compile error in a constant expression).
+ */
+template <static_bytes... Parts>
+[[nodiscard]] constexpr auto bytes_concat(Parts&&... parts) {
+    byte_array<(detail::static_bytes_extent_v<Parts> + ... + 0)> ret{};
+    [[maybe_unused]] std::byte* out = ret.data();
+    ((out = detail::static_bytes_copy(out, parts)), ...);
+    return ret;
+}
+
+/**
+ * Compute the 64-bit FNV-1a hash of the given bytes. This may be evaluated at
+ * compile-time for a byte_array, e.g. the result of bytes_concat(), and at
+ * runtime for any buffer range. The hash of a buffer range is the hash of its
+ * concatenated bytes, regardless of how they are split between buffers.
+ */
+[[nodiscard]] constexpr std::uint64_t bytes_hash(const_buffer buf) noexcept {
+    return detail::fnv1a_update(detail::fnv1a_offset_basis, buf.data(), buf.size());
+}
+
+template <std::size_t N>
+[[nodiscard]] constexpr std::uint64_t bytes_hash(const byte_array<N>& arr) noexcept {
+    return detail::fnv1a_update(detail::fnv1a_offset_basis, arr.data(), N);
+}
+
+template <buffer_range Bufs>
+requires(!single_buffer<Bufs>)  //
+    [[nodiscard]] constexpr std::uint64_t bytes_hash(const Bufs& bufs) noexcept {
+    auto h = detail::fnv1a_offset_basis;
+    for (const_buffer buf : bufs) {
+        h = detail::fnv1a_update(h, buf.data(), buf.size());
+    }
+    return h;
+}
+
+}  // namespace neo
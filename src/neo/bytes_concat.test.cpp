@@ -0,0 +1,66 @@
+#include <neo/bytes_concat.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffers_cat.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+#include <string_view>
+
+using namespace std::literals;
+
+NEO_TEST_CONCEPT(neo::static_bytes<neo::byte_array<4>>);
+NEO_TEST_CONCEPT(neo::static_bytes<decltype("Hello")>);
+NEO_TEST_CONCEPT(neo::static_bytes<std::array<std::byte, 3>>);
+NEO_TEST_CONCEPT(!neo::static_bytes<neo::const_buffer>);
+// A mutable char array might not be null-terminated, so it is not a string literal
+NEO_TEST_CONCEPT(!neo::static_bytes<char(&)[6]>);
+
+namespace {
+
+constexpr neo::byte_array crlf = {std::byte{'\r'}, std::byte{'\n'}};
+
+constexpr auto status_line = neo::bytes_concat("HTTP/1.1 ", "200 OK", crlf);
+static_assert(status_line.size() == 17);
+static_assert(status_line[9] == std::byte{'2'});
+static_assert(status_line[16] == std::byte{'\n'});
+
+static_assert(neo::bytes_concat().size() == 0);
+
+// FNV-1a test vectors
+static_assert(neo::bytes_hash(neo::bytes_concat()) == 0xcbf29ce484222325);
+static_assert(neo::bytes_hash(neo::bytes_concat("a")) == 0xaf63dc4c8601ec8c);
+static_assert(neo::bytes_hash(neo::bytes_concat("foo", "bar")) == 0x85944171f73967e8);
+
+}  // namespace
+
+TEST_CASE("Concatenate compile-time byte sequences") {
+    std::array<std::byte, 3> arr = {std::byte{'a'}, std::byte{'b'}, std::byte{'c'}};
+
+    auto bytes = neo::bytes_concat(arr, "-", arr);
+    CHECK(neo::const_buffer(neo::as_buffer(bytes)).equals_string("abc-abc"sv));
+
+    CHECK(neo::as_buffer(status_line).equals_string("HTTP/1.1 200 OK\r\n"sv));
+}
+
+TEST_CASE("Hash bytes at compile-time and at runtime") {
+    constexpr auto key = neo::bytes_hash(status_line);
+
+    // The same bytes hash to the same value, however they are split
+    std::string_view str = "HTTP/1.1 200 OK\r\n";
+    CHECK(neo::bytes_hash(neo::as_buffer(str)) == key);
+    auto cat = neo::buffers_cat(neo::as_buffer(str.substr(0, 4)),
+                                neo::const_buffer(),
+                                neo::as_buffer(str.substr(4)));
+    CHECK(neo::bytes_hash(cat) == key);
+
+    CHECK(neo::bytes_hash(neo::as_buffer("HTTP/1.1 404 Not Found\r\n"sv)) != key);
+}
+
+TEST_CASE("A const char array without a null terminator is rejected") {
+    const char not_a_string[3] = {'a', 'b', 'c'};
+    CHECK_THROWS_AS(neo::bytes_concat(not_a_string), std::invalid_argument);
+}
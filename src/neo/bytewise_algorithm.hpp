@@ -0,0 +1,178 @@
+#pragma once
+
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffer_algorithm/size.hpp>
+#include <neo/bytewise_iterator.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <neo/iterator_concepts.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+namespace neo {
+
+/**
+ * The algorithms in this file are equivalent to their namesakes in <algorithm>,
+ * but operate on each contiguous segment between a pair of byte iterators as a
+ * whole, rather than stepping through the multi-buffer iterator logic for every
+ * byte. Each segment is handed to a memcpy/memchr/memset/memcmp-class kernel.
+ */
+
+namespace detail {
+
+constexpr const std::byte*
+ll_find_byte(const std::byte* ptr, std::size_t size, std::byte value) noexcept {
+#ifdef __cpp_lib_is_constant_evaluated
+    if (!std::is_constant_evaluated()) {
+        auto found = std::memchr(ptr, static_cast<int>(value), size);
+        return found ? static_cast<const std::byte*>(found) : ptr + size;
+    }
+#endif
+    return std::find(ptr, ptr + size, value);
+}
+
+constexpr void ll_fill_bytes(std::byte* ptr, std::size_t size, std::byte value) noexcept {
+#ifdef __cpp_lib_is_constant_evaluated
+    if (!std::is_constant_evaluated()) {
+        std::memset(ptr, static_cast<int>(value), size);
+        return;
+    }
+#endif
+    std::fill_n(ptr, size, value);
+}
+
+constexpr bool ll_equal_bytes(const std::byte* a, const std::byte* b, std::size_t size) noexcept {
+#ifdef __cpp_lib_is_constant_evaluated
+    if (!std::is_constant_evaluated()) {
+        return size == 0 || std::memcmp(a, b, size) == 0;
+    }
+#endif
+    return std::equal(a, a + size, b);
+}
+
+}  // namespace detail
+
+/**
+ * Copy the bytes in [first, last) into `out`, returning the end of the
+ * written range. If `out` is itself a segmented byte iterator, the copy is
+ * performed segment-to-segment.
+ */
+template <segmented_byte_iterator Iter, output_iterator<std::byte> Out>
+constexpr Out bytewise_copy(Iter first, Iter last, Out out) {
+    auto segs = bytewise_segments(first, last);
+    if constexpr (segmented_byte_iterator<Out>) {
+        auto out_last = std::ranges::next(out, static_cast<std::ptrdiff_t>(buffer_size(segs)));
+        buffer_copy(bytewise_segments(out, out_last), segs);
+        return out_last;
+    } else if constexpr (std::is_same_v<Out, std::byte*>) {
+        for (const_buffer seg : segs) {
+            ll_buffer_copy_fast(out, seg.data(), seg.size());
+            out += seg.size();
+        }
+        return out;
+    } else {
+        for (const_buffer seg : segs) {
+            out = std::copy(seg.data(), seg.data_end(), out);
+        }
+        return out;
+    }
+}
+
+/**
+ * Find the first byte in [first, last) that is equal to `value`. Returns `last`
+ * if there is no such byte.
+ */
+template <segmented_byte_iterator Iter>
+constexpr Iter bytewise_find(Iter first, Iter last, std::byte value) {
+    std::size_t skipped = 0;
+    for (const_buffer seg : bytewise_segments(first, last)) {
+        auto found = detail::ll_find_byte(seg.data(), seg.size(), value);
+        if (found != seg.data_end()) {
+            auto off = skipped + static_cast<std::size_t>(found - seg.data());
+            return std::ranges::next(first, static_cast<std::ptrdiff_t>(off));
+        }
+        skipped += seg.size();
+    }
+    return last;
+}
+
+/**
+ * Count the bytes in [first, last) that are equal to `value`.
+ */
+template <segmented_byte_iterator Iter>
+constexpr std::ptrdiff_t bytewise_count(Iter first, Iter last, std::byte value) {
+    std::ptrdiff_t count = 0;
+    for (const_buffer seg : bytewise_segments(first, last)) {
+        count += std::count(seg.data(), seg.data_end(), value);
+    }
+    return count;
+}
+
+/**
+ * Set every byte in [first, last) to `value`. The iterators must refer to
+ * mutable buffers.
+ */
+template <segmented_byte_iterator Iter>
+requires mutable_buffer_range<decltype(bytewise_segments(std::declval<Iter>(),
+                                                         std::declval<Iter>()))>  //
+    constexpr void bytewise_fill(Iter first, Iter last, std::byte value) {
+    for (mutable_buffer seg : bytewise_segments(first, last)) {
+        detail::ll_fill_bytes(seg.data(), seg.size(), value);
+    }
+}
+
+/**
+ * Determine whether the bytes in [first, last) are equal to the same number of
+ * bytes beginning at `first2`. `first2` may be a segmented byte iterator, in
+ * which case the two segment ranges are compared in lockstep.
+ */
+template <segmented_byte_iterator Iter, input_iterator Iter2>
+constexpr bool bytewise_equal(Iter first, Iter last, Iter2 first2) {
+    auto segs = bytewise_segments(first, last);
+    if constexpr (segmented_byte_iterator<Iter2>) {
+        auto last2  = std::ranges::next(first2, static_cast<std::ptrdiff_t>(buffer_size(segs)));
+        auto segs2  = bytewise_segments(first2, last2);
+        auto other  = segs2.begin();
+        auto b_here = const_buffer();
+        for (const_buffer seg : segs) {
+            while (!seg.empty()) {
+                if (b_here.empty()) {
+                    b_here = *other;
+                    ++other;
+                }
+                auto n = (std::min)(seg.size(), b_here.size());
+                if (!detail::ll_equal_bytes(seg.data(), b_here.data(), n)) {
+                    return false;
+                }
+                seg += n;
+                b_here += n;
+            }
+        }
+        return true;
+    } else if constexpr (std::is_convertible_v<Iter2, const std::byte*>) {
+        const std::byte* ptr = first2;
+        for (const_buffer seg : segs) {
+            if (!detail::ll_equal_bytes(seg.data(), ptr, seg.size())) {
+                return false;
+            }
+            ptr += seg.size();
+        }
+        return true;
+    } else {
+        for (const_buffer seg : segs) {
+            auto [here, there] = std::mismatch(seg.data(), seg.data_end(), first2);
+            if (here != seg.data_end()) {
+                return false;
+            }
+            first2 = there;
+        }
+        return true;
+    }
+}
+
+}  // namespace neo
@@ -0,0 +1,150 @@
+#include <neo/bytewise_algorithm.hpp>
+
+#include <neo/buffer_algorithm.hpp>
+#include <neo/bytewise_index.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+NEO_TEST_CONCEPT(neo::segmented_byte_iterator<neo::bytewise_iterator<neo::const_buffer>>);
+NEO_TEST_CONCEPT(
+    neo::segmented_byte_iterator<neo::bytewise_iterator<std::vector<neo::const_buffer>>>);
+NEO_TEST_CONCEPT(neo::segmented_byte_iterator<neo::bytewise_index<neo::const_buffer>::iterator>);
+
+namespace {
+
+std::string to_string(neo::const_buffer b) {
+    return std::string(reinterpret_cast<const char*>(b.data()), b.size());
+}
+
+}  // namespace
+
+TEST_CASE("Get the segments between two bytewise iterators") {
+    std::vector<neo::const_buffer> bufs = {
+        neo::const_buffer("Hello, "),
+        neo::const_buffer(""),
+        neo::const_buffer("world"),
+        neo::const_buffer("!"),
+    };
+    neo::bytewise_iterator it{bufs};
+    auto                   stop = it.end();
+
+    auto all = neo::bytewise_segments(it, stop);
+    CHECK(neo::buffer_size(all) == 13);
+    CHECK(neo::buffer_count(all) == 3);
+
+    // Begin part-way through the first buffer, and end part-way through the second
+    auto first = std::next(it, 4);
+    auto last  = std::next(it, 9);
+    auto segs  = neo::bytewise_segments(first, last);
+    CHECK(neo::buffer_size(segs) == 5);
+    std::vector<std::string> parts;
+    for (neo::const_buffer b : segs) {
+        parts.push_back(to_string(b));
+    }
+    CHECK(parts == std::vector<std::string>{"o, ", "wo"});
+
+    // Beginning exactly at a buffer boundary
+    segs = neo::bytewise_segments(std::next(it, 7), stop);
+    parts.clear();
+    for (neo::const_buffer b : segs) {
+        parts.push_back(to_string(b));
+    }
+    CHECK(parts == std::vector<std::string>{"world", "!"});
+
+    CHECK(neo::buffer_size(neo::bytewise_segments(first, first)) == 0);
+
+    // A single buffer has a single segment
+    neo::bytewise_iterator single{neo::const_buffer("single")};
+    auto                   seg = neo::bytewise_segments(std::next(single, 1), single.end());
+    CHECK(seg.equals_string(std::string_view("ingle")));
+}
+
+TEST_CASE("Run algorithms over bytewise iterators") {
+    std::vector<neo::const_buffer> bufs = {
+        neo::const_buffer("abc"),
+        neo::const_buffer("defg"),
+        neo::const_buffer(""),
+        neo::const_buffer("hij"),
+    };
+    neo::bytewise_iterator it{bufs};
+    auto                   stop = it.end();
+
+    std::string out;
+    out.resize(10);
+    auto out_end = neo::bytewise_copy(it, stop, neo::byte_pointer(out.data()));
+    CHECK(out == "abcdefghij");
+    CHECK(out_end == neo::byte_pointer(out.data()) + 10);
+
+    std::vector<std::byte> vec;
+    neo::bytewise_copy(std::next(it, 2), std::next(it, 8), std::back_inserter(vec));
+    CHECK(vec.size() == 6);
+    CHECK(vec.front() == std::byte{'c'});
+    CHECK(vec.back() == std::byte{'h'});
+
+    auto found = neo::bytewise_find(it, stop, std::byte{'h'});
+    CHECK(found - it == 7);
+    CHECK(*found == std::byte{'h'});
+    CHECK(neo::bytewise_find(it, stop, std::byte{'z'}) == stop);
+    CHECK(neo::bytewise_find(std::next(it, 8), stop, std::byte{'a'}) == stop);
+
+    CHECK(neo::bytewise_count(it, stop, std::byte{'d'}) == 1);
+    CHECK(neo::bytewise_count(it, stop, std::byte{'z'}) == 0);
+
+    CHECK(neo::bytewise_equal(it, stop, neo::byte_pointer(out.data())));
+    out[9] = 'x';
+    CHECK_FALSE(neo::bytewise_equal(it, stop, neo::byte_pointer(out.data())));
+    // Compare against a plain iterator
+    CHECK(neo::bytewise_equal(std::next(it, 2), std::next(it, 8), vec.begin()));
+    CHECK_FALSE(neo::bytewise_equal(it, std::next(it, 6), vec.begin()));
+}
+
+TEST_CASE("Copy and compare between differently segmented ranges") {
+    std::string a = "0123";
+    std::string b = "456789";
+    std::string c = "0123456";
+    std::string d = "789";
+
+    std::vector<neo::mutable_buffer> left  = {neo::as_buffer(a), neo::as_buffer(b)};
+    std::vector<neo::mutable_buffer> right = {neo::as_buffer(c), neo::as_buffer(d)};
+
+    neo::bytewise_iterator l_it{left};
+    neo::bytewise_iterator r_it{right};
+    CHECK(neo::bytewise_equal(l_it, l_it.end(), r_it));
+
+    neo::bytewise_fill(std::next(r_it, 5), std::next(r_it, 9), std::byte{'-'});
+    CHECK(c == "01234--");
+    CHECK(d == "--9");
+    CHECK_FALSE(neo::bytewise_equal(l_it, l_it.end(), r_it));
+    CHECK(neo::bytewise_equal(l_it, std::next(l_it, 5), r_it));
+
+    // Segment-to-segment copy
+    auto r_end = neo::bytewise_copy(l_it, l_it.end(), r_it);
+    CHECK(r_end == r_it.end());
+    CHECK(c == "0123456");
+    CHECK(d == "789");
+}
+
+TEST_CASE("Run algorithms over an indexed byte range") {
+    std::vector<neo::const_buffer> bufs = {
+        neo::const_buffer("The quick "),
+        neo::const_buffer("brown fox "),
+        neo::const_buffer("jumps"),
+    };
+    neo::bytewise_index idx{bufs};
+
+    auto segs = neo::bytewise_segments(idx.begin() + 4, idx.begin() + 24);
+    CHECK(neo::buffer_count(segs) == 3);
+    CHECK(neo::buffer_size(segs) == 20);
+
+    auto found = neo::bytewise_find(idx.begin(), idx.end(), std::byte{'j'});
+    CHECK(found.position() == 20);
+    CHECK(neo::bytewise_count(idx.begin(), idx.end(), std::byte{' '}) == 4);
+
+    std::string flat = "The quick brown fox jumps";
+    CHECK(neo::bytewise_equal(idx.begin(), idx.end(), neo::byte_pointer(flat.data())));
+}
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <neo/buffer_range.hpp>
+#include <neo/detail/byte_segment_range.hpp>
+#include <neo/flat_buffer_sequence.hpp>
+
+#include <neo/assert.hpp>
+#include <neo/iterator_facade.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace neo {
+
+template <typename BufferType, std::size_t InlineCount>
+class indexed_bytewise_iterator;
+
+/**
+ * A `bytewise_index` flattens a buffer range and builds a table of the byte
+ * offset at which each buffer begins. With that table, a byte position can be
+ * mapped to a buffer in O(log n) time, and distances between positions are
+ * computed in O(1) time.
+ *
+ * Iterate the bytes with `begin()` and `end()`, which return
+ * `indexed_bytewise_iterator`s. The iterators refer to the index, so the index
+ * must outlive them. The index views the same memory as the buffer range it
+ * was built from, so that memory must outlive the index.
+ */
+template <typename BufferType, std::size_t InlineCount = 16>
+class bytewise_index {
+public:
+    using buffer_type    = BufferType;
+    using sequence_type  = flat_buffer_sequence<buffer_type, InlineCount>;
+    using iterator       = indexed_bytewise_iterator<BufferType, InlineCount>;
+    using const_iterator = iterator;
+
+private:
+    sequence_type _bufs;
+    /// The absolute offset of the beginning of each buffer in `_bufs`
+    std::vector<std::size_t> _offsets;
+
+    void _build() {
+        _offsets.reserve(_bufs.size());
+        std::size_t off = 0;
+        for (const_buffer b : _bufs) {
+            _offsets.push_back(off);
+            off += b.size();
+        }
+    }
+
+public:
+    bytewise_index() = default;
+
+    template <buffer_range Bufs>
+    requires(!alike<Bufs, bytewise_index>)  //
+        explicit bytewise_index(const Bufs& bufs)
+        : _bufs(bufs) {
+        _build();
+    }
+
+    /// The buffers being indexed. Empty buffers from the original range are omitted.
+    [[nodiscard]] const sequence_type& buffers() const noexcept { return _bufs; }
+
+    /// The total number of bytes in the indexed buffers
+    [[nodiscard]] std::size_t size() const noexcept { return _bufs.byte_size(); }
+
+    /// The number of (non-empty) buffers that were indexed
+    [[nodiscard]] std::size_t segment_count() const noexcept { return _bufs.size(); }
+
+    /// The absolute byte offset at which the `n`th buffer begins
+    [[nodiscard]] std::size_t segment_offset(std::size_t n) const noexcept {
+        if (n == segment_count()) {
+            return size();
+        }
+        neo_assert(expects,
+                   n < segment_count(),
+                   "Segment index is out-of-range",
+                   n,
+                   segment_count());
+        return _offsets[n];
+    }
+
+    /**
+     * Find the buffer that contains the byte at `pos`. Returns the index of the
+     * buffer. If `pos == size()`, returns `segment_count()`.
+     */
+    [[nodiscard]] std::size_t segment_of(std::size_t pos) const noexcept {
+        neo_assert(expects,
+                   pos <= size(),
+                   "Cannot locate a byte beyond the end of the indexed buffers",
+                   pos,
+                   size());
+        if (pos == size()) {
+            return segment_count();
+        }
+        auto it = std::upper_bound(_offsets.begin(), _offsets.end(), pos);
+        return static_cast<std::size_t>(it - _offsets.begin()) - 1;
+    }
+
+    /**
+     * Obtain a reference to the byte at absolute position `pos`.
+     */
+    [[nodiscard]] auto& operator[](std::size_t pos) const noexcept {
+        neo_assert(expects, pos < size(), "Byte offset is out-of-range", pos, size());
+        auto seg = segment_of(pos);
+        return _bufs[seg][pos - _offsets[seg]];
+    }
+
+    /**
+     * Obtain a buffer range viewing `length` bytes of the indexed buffers,
+     * beginning at `offset`. The length is clamped to the bytes available. The
+     * beginning of the slice is located in O(log n) time.
+     */
+    [[nodiscard]] auto slice(std::size_t offset,
+                             std::size_t length = std::numeric_limits<std::size_t>::max()) const
+        noexcept {
+        auto seg = segment_of(offset);
+        auto len = (std::min)(length, size() - offset);
+        return detail::byte_segment_range<const buffer_type*>(_bufs.begin() + seg,
+                                                               offset - segment_offset(seg),
+                                                               len);
+    }
+
+    [[nodiscard]] iterator begin() const noexcept { return iterator(*this, 0, 0); }
+    [[nodiscard]] iterator end() const noexcept { return iterator(*this, segment_count(), size()); }
+};
+
+template <buffer_range Bufs>
+explicit bytewise_index(const Bufs&) -> bytewise_index<buffer_range_value_t<Bufs>>;
+
+/**
+ * A random-access iterator over the bytes of a `bytewise_index`. Stepping
+ * within a buffer, or onto an adjacent buffer, is O(1). Other jumps perform a
+ * binary search of the index.
+ */
+template <typename BufferType, std::size_t InlineCount>
+class indexed_bytewise_iterator
+    : public iterator_facade<indexed_bytewise_iterator<BufferType, InlineCount>> {
+    using index_type = bytewise_index<BufferType, InlineCount>;
+
+    const index_type* _index = nullptr;
+    /// The index of the buffer containing the current byte
+    std::size_t _seg = 0;
+    /// The absolute position of the current byte
+    std::size_t _pos = 0;
+
+public:
+    constexpr indexed_bytewise_iterator() = default;
+
+    constexpr indexed_bytewise_iterator(const index_type& idx,
+                                        std::size_t       seg,
+                                        std::size_t       pos) noexcept
+        : _index(&idx)
+        , _seg(seg)
+        , _pos(pos) {}
+
+    /// The absolute byte offset of this iterator within the index
+    [[nodiscard]] constexpr std::size_t position() const noexcept { return _pos; }
+
+    /// The index of the buffer that contains the byte referred to by this iterator
+    [[nodiscard]] constexpr std::size_t segment() const noexcept { return _seg; }
+
+    constexpr auto& dereference() const noexcept {
+        neo_assert(expects,
+                   _pos < _index->size(),
+                   "Dereferenced a past-the-end indexed_bytewise_iterator",
+                   _pos,
+                   _index->size());
+        return _index->buffers()[_seg][_pos - _index->segment_offset(_seg)];
+    }
+
+    constexpr void advance(std::ptrdiff_t off) noexcept {
+        neo_assert(expects,
+                   (off >= 0 || static_cast<std::size_t>(-off) <= _pos)
+                       && (off <= 0 || static_cast<std::size_t>(off) <= _index->size() - _pos),
+                   "Advanced an indexed_bytewise_iterator out of the bounds of its buffers",
+                   off,
+                   _pos,
+                   _index->size());
+        const auto new_pos = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(_pos) + off);
+        _pos               = new_pos;
+        // Fast path: Still within the same buffer
+        if (_seg < _index->segment_count() && new_pos >= _index->segment_offset(_seg)
+            && new_pos < _index->segment_offset(_seg + 1)) {
+            return;
+        }
+        // Fast path: Stepped onto the following buffer
+        if (_seg + 1 <= _index->segment_count() && new_pos == _index->segment_offset(_seg + 1)) {
+            ++_seg;
+            return;
+        }
+        // Fast path: Stepped back into the preceding buffer
+        if (_seg > 0 && new_pos < _index->segment_offset(_seg)
+            && new_pos >= _index->segment_offset(_seg - 1)) {
+            --_seg;
+            return;
+        }
+        _seg = _index->segment_of(new_pos);
+    }
+
+    constexpr std::ptrdiff_t distance_to(const indexed_bytewise_iterator& other) const noexcept {
+        return static_cast<std::ptrdiff_t>(other._pos) - static_cast<std::ptrdiff_t>(_pos);
+    }
+
+    constexpr bool operator==(const indexed_bytewise_iterator& other) const noexcept {
+        return _pos == other._pos;
+    }
+
+    /**
+     * Obtain a buffer range of the contiguous segments of memory between this
+     * iterator and `last`.
+     */
+    [[nodiscard]] constexpr auto segments_to(const indexed_bytewise_iterator& last) const noexcept {
+        neo_assert(expects,
+                   _pos <= last._pos,
+                   "indexed_bytewise_iterator segments requested for a reversed iterator pair",
+                   _pos,
+                   last._pos);
+        return detail::byte_segment_range<const BufferType*>(_index->buffers().begin() + _seg,
+                                                             _pos - _index->segment_offset(_seg),
+                                                             last._pos - _pos);
+    }
+};
+
+}  // namespace neo
@@ -0,0 +1,78 @@
+#include <neo/bytewise_index.hpp>
+
+#include <neo/buffer_algorithm.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+
+NEO_TEST_CONCEPT(
+    neo::random_access_iterator<neo::indexed_bytewise_iterator<neo::const_buffer, 16>>);
+NEO_TEST_CONCEPT(
+    neo::random_access_iterator<neo::indexed_bytewise_iterator<neo::mutable_buffer, 16>>);
+
+TEST_CASE("Index an empty buffer sequence") {
+    std::vector<neo::const_buffer> empty;
+    neo::bytewise_index            idx{empty};
+    CHECK(idx.size() == 0);
+    CHECK(idx.begin() == idx.end());
+    CHECK(idx.end() - idx.begin() == 0);
+}
+
+TEST_CASE("Random access into many small buffers") {
+    auto bufs = {
+        neo::const_buffer("first"),
+        neo::const_buffer(""),
+        neo::const_buffer("second"),
+        neo::const_buffer("third"),
+    };
+    neo::bytewise_index idx{bufs};
+    CHECK(idx.size() == 16);
+    CHECK(idx.segment_count() == 3);
+    CHECK(idx.segment_of(0) == 0);
+    CHECK(idx.segment_of(4) == 0);
+    CHECK(idx.segment_of(5) == 1);
+    CHECK(idx.segment_of(15) == 2);
+    CHECK(idx.segment_of(16) == 3);
+    CHECK((char)idx[5] == 's');
+
+    auto it   = idx.begin();
+    auto stop = idx.end();
+    CHECK(stop - it == 16);
+    CHECK((char)it[11] == 't');
+    CHECK((char)*(it + 15) == 'd');
+    CHECK((char)*(stop - 6) == 'd');
+
+    std::string str;
+    std::transform(it, stop, std::back_inserter(str), [](std::byte b) { return (char)b; });
+    CHECK(str == "firstsecondthird");
+
+    // Walk backwards across buffer boundaries
+    std::string rev;
+    while (stop != it) {
+        --stop;
+        rev.push_back((char)*stop);
+    }
+    CHECK(rev == "drihtdnocestsrif");
+}
+
+TEST_CASE("Patch bytes through an index") {
+    std::string a = "head";
+    std::string b = "er_body";
+    auto        bufs = {neo::mutable_buffer(a), neo::mutable_buffer(b)};
+
+    neo::bytewise_index idx{bufs};
+    auto                it = idx.begin() + 5;
+    *it                    = std::byte{'R'};
+    std::fill(idx.begin() + 7, idx.end(), std::byte{'X'});
+    CHECK(a == "head");
+    CHECK(b == "eR_XXXX");
+    CHECK(std::find(idx.begin(), idx.end(), std::byte{'_'}) - idx.begin() == 6);
+}
@@ -2,6 +2,7 @@
 
 #include <neo/as_buffer.hpp>
 #include <neo/buffer_range.hpp>
+#include <neo/detail/byte_segment_range.hpp>
 
 #include <neo/assert.hpp>
 #include <neo/iterator_concepts.hpp>
@@ -122,6 +123,22 @@ public:
     }
 
     constexpr auto& dereference() const noexcept { return (*_cur)[_cur_buf_pos]; }
+
+    /**
+     * Obtain a buffer range of the contiguous segments of memory between this
+     * iterator and `last`. The returned range refers to the same buffers as
+     * the iterators.
+     */
+    [[nodiscard]] constexpr auto segments_to(const bytewise_iterator& last) const noexcept {
+        neo_assert(expects,
+                   _abs_pos <= last._abs_pos,
+                   "bytewise_iterator segments requested for a reversed iterator pair",
+                   _abs_pos,
+                   last._abs_pos);
+        return detail::byte_segment_range<inner_iter_type>(_cur,
+                                                           _cur_buf_pos,
+                                                           last._abs_pos - _abs_pos);
+    }
 };
 
 template <single_buffer T>
@@ -164,9 +181,42 @@ public:
     constexpr bool operator==(const bytewise_iterator& other) const noexcept {
         return other._idx == _idx;
     }
+
+    /**
+     * Obtain the single buffer that views the bytes between this iterator and `last`
+     */
+    [[nodiscard]] constexpr auto segments_to(const bytewise_iterator& last) const noexcept {
+        neo_assert(expects,
+                   _idx <= last._idx,
+                   "bytewise_iterator segments requested for a reversed iterator pair",
+                   _idx,
+                   last._idx);
+        return (_buf + _idx).first(last._idx - _idx);
+    }
 };
 
 template <typename T>
 bytewise_iterator(const T&) -> bytewise_iterator<T>;
 
+// clang-format off
+/**
+ * An iterator of bytes that can present a range of its bytes as a buffer range
+ * of contiguous segments.
+ */
+template <typename Iter>
+concept segmented_byte_iterator = requires(const Iter first, const Iter last) {
+    { first.segments_to(last) } -> buffer_range;
+};
+// clang-format on
+
+/**
+ * Obtain a buffer range of the contiguous memory segments between two byte
+ * iterators. Algorithms can operate on each segment as a whole rather than
+ * stepping through the bytes one-at-a-time.
+ */
+template <segmented_byte_iterator Iter>
+[[nodiscard]] constexpr auto bytewise_segments(const Iter& first, const Iter& last) noexcept {
+    return first.segments_to(last);
+}
+
 }  // namespace neo
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#ifdef __has_include
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+
+namespace neo::detail {
+
+/**
+ * Block while the atomic object `a` (a `std::atomic` or `std::atomic_ref`)
+ * holds `old`. May return spuriously.
+ *
+ * Uses `wait()` where the standard library provides it (a futex on Linux).
+ * Otherwise (e.g. libstdc++ 10), spins for a short while and then yields the
+ * thread until the value changes.
+ */
+template <typename Atomic, typename T>
+void atomic_wait(const Atomic& a, T old, std::memory_order order) noexcept {
+#if __cpp_lib_atomic_wait
+    a.wait(old, order);
+#else
+    for (int n_spins = 0; a.load(order) == old; ++n_spins) {
+        if (n_spins >= 64) {
+            std::this_thread::yield();
+        }
+    }
+#endif
+}
+
+/// Wake one thread blocked in atomic_wait() on `a`
+template <typename Atomic>
+void atomic_notify_one(Atomic&& a) noexcept {
+#if __cpp_lib_atomic_wait
+    a.notify_one();
+#else
+    // Waiters poll the value
+    (void)a;
+#endif
+}
+
+/// Wake every thread blocked in atomic_wait() on `a`
+template <typename Atomic>
+void atomic_notify_all(Atomic&& a) noexcept {
+#if __cpp_lib_atomic_wait
+    a.notify_all();
+#else
+    (void)a;
+#endif
+}
+
+/**
+ * Counts the threads that are blocked waiting for an atomic to change, so that
+ * the thread that changes it only issues a notification when someone is
+ * actually waiting. (Even an unneeded `notify_one()` is not free: libstdc++
+ * implements it through a shared table of waiters.)
+ *
+ * The waiting side announces itself before re-checking the value, and the
+ * notifying side issues a seq_cst fence between its store and its check of the
+ * count. One of the two is therefore guaranteed to see the other, and a wakeup
+ * cannot be lost.
+ */
+class atomic_waiters {
+    std::atomic<std::uint32_t> _count{0};
+
+public:
+    /**
+     * Block while `a` holds `old`. May return spuriously, so the caller should
+     * re-check its condition.
+     */
+    template <typename Atomic, typename T>
+    void wait(const Atomic& a, T old) noexcept {
+        _count.fetch_add(1, std::memory_order_seq_cst);
+        if (a.load(std::memory_order_seq_cst) == old) {
+            atomic_wait(a, old, std::memory_order_acquire);
+        }
+        _count.fetch_sub(1, std::memory_order_release);
+    }
+
+    /// Call after storing to `a`. Wakes one waiter, if there are any.
+    template <typename Atomic>
+    void notify_one(Atomic&& a) noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_count.load(std::memory_order_relaxed)) {
+            atomic_notify_one(a);
+        }
+    }
+
+    /// Call after storing to `a`. Wakes all waiters, if there are any.
+    template <typename Atomic>
+    void notify_all(Atomic&& a) noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_count.load(std::memory_order_relaxed)) {
+            atomic_notify_all(a);
+        }
+    }
+};
+
+}  // namespace neo::detail
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <neo/fwd.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * A minimal benchmark runner shared by the `bench_*.main.cpp` applications. It
+ * is not part of the library interface.
+ */
+
+namespace neo::bench {
+
+/**
+ * Prevent the compiler from discarding the computation of `value`.
+ */
+template <typename T>
+inline void do_not_optimize(const T& value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+/**
+ * The result of one benchmark. `counters` holds any additional named values to
+ * include in the output.
+ */
+struct bench_result {
+    std::string                                  name;
+    std::uint64_t                                iterations    = 0;
+    std::size_t                                  bytes_per_op  = 0;
+    double                                       ns_per_op     = 0;
+    double                                       bytes_per_sec = 0;
+    std::vector<std::pair<std::string, double>>  counters;
+
+    /// Add a named value to the output
+    bench_result& counter(std::string key, double value) {
+        counters.emplace_back(std::move(key), value);
+        return *this;
+    }
+
+    /// Obtain a value added with counter(), or zero if there is none with the given name
+    [[nodiscard]] double counter_value(std::string_view key) const noexcept {
+        for (auto& [k, v] : counters) {
+            if (k == key) {
+                return v;
+            }
+        }
+        return 0;
+    }
+};
+
+struct bench_options {
+    /// The minimum time to spend measuring each benchmark
+    std::chrono::duration<double> min_time{0.25};
+    /// The number of measurements to take. The fastest is reported.
+    int repetitions = 3;
+    /// Only benchmarks whose name contains this string are run
+    std::string filter;
+};
+
+namespace detail {
+
+inline void write_json_string(std::ostream& out, std::string_view str) {
+    out << '"';
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char esc[8];
+            std::snprintf(esc, sizeof esc, "\\u%04x", c);
+            out << esc;
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+}  // namespace detail
+
+/**
+ * Runs benchmarks and collects their results.
+ *
+ * Each benchmark is a callable that performs one operation. It is called in
+ * batches of increasing size until a batch takes at least `min_time`, and the
+ * batch is then repeated. The fastest repetition is reported.
+ */
+class bench_runner {
+    bench_options            _opts;
+    std::deque<bench_result> _results;
+    std::vector<std::string> _findings;
+
+public:
+    bench_runner() = default;
+    explicit bench_runner(bench_options opts)
+        : _opts(std::move(opts)) {}
+
+    /**
+     * Parse `--min-time=<seconds>`, `--repetitions=<n>`, and `--filter=<string>`.
+     */
+    static bench_options parse_args(int argc, const char* const* argv) {
+        bench_options opts;
+        for (int i = 1; i < argc; ++i) {
+            std::string_view arg = argv[i];
+            auto             val = [&](std::string_view key) -> std::string_view {
+                return arg.substr(key.size());
+            };
+            if (arg.starts_with("--min-time=")) {
+                opts.min_time = std::chrono::duration<double>(
+                    std::strtod(std::string(val("--min-time=")).c_str(), nullptr));
+            } else if (arg.starts_with("--repetitions=")) {
+                opts.repetitions
+                    = (std::max)(1, std::atoi(std::string(val("--repetitions=")).c_str()));
+            } else if (arg.starts_with("--filter=")) {
+                opts.filter = std::string(val("--filter="));
+            } else {
+                std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+                std::exit(2);
+            }
+        }
+        return opts;
+    }
+
+    [[nodiscard]] const bench_options& options() const noexcept { return _opts; }
+
+    [[nodiscard]] bool selected(std::string_view name) const noexcept {
+        return _opts.filter.empty() || name.find(_opts.filter) != std::string_view::npos;
+    }
+
+    /**
+     * Measure `fn`, which processes `bytes_per_op` bytes in each call. Returns
+     * the result, or nullptr if the benchmark is not selected by the filter.
+     * The result remains valid as more benchmarks are run.
+     */
+    template <typename Fn>
+    bench_result* run(std::string name, std::size_t bytes_per_op, Fn&& fn) {
+        if (!selected(name)) {
+            return nullptr;
+        }
+        using clock = std::chrono::steady_clock;
+
+        auto time_batch = [&](std::uint64_t n) {
+            const auto start = clock::now();
+            for (std::uint64_t i = 0; i < n; ++i) {
+                fn();
+            }
+            return std::chrono::duration<double>(clock::now() - start);
+        };
+
+        // Find a batch size that takes at least min_time
+        std::uint64_t batch   = 1;
+        auto          elapsed = time_batch(batch);
+        while (elapsed < _opts.min_time && batch < (std::uint64_t(1) << 40)) {
+            const auto scale = elapsed.count() > 0 ? _opts.min_time / elapsed * 1.2 : 10.0;
+            batch            = (std::max)(batch + 1,
+                               static_cast<std::uint64_t>(double(batch) * (std::min)(scale, 10.0)));
+            elapsed          = time_batch(batch);
+        }
+        for (int rep = 1; rep < _opts.repetitions; ++rep) {
+            elapsed = (std::min)(elapsed, time_batch(batch));
+        }
+
+        bench_result res;
+        res.name          = std::move(name);
+        res.iterations    = batch;
+        res.bytes_per_op  = bytes_per_op;
+        res.ns_per_op     = elapsed.count() * 1e9 / double(batch);
+        res.bytes_per_sec = res.ns_per_op > 0 ? double(bytes_per_op) * 1e9 / res.ns_per_op : 0;
+        std::fprintf(stderr,
+                     "%-56s %12.2f ns/op %10.2f MiB/s\n",
+                     res.name.c_str(),
+                     res.ns_per_op,
+                     res.bytes_per_sec / (1024 * 1024));
+        _results.push_back(std::move(res));
+        return &_results.back();
+    }
+
+    [[nodiscard]] const std::deque<bench_result>& results() const noexcept { return _results; }
+
+    /**
+     * Record a conclusion drawn from the results. Findings are written to
+     * stderr immediately, and included in the JSON output.
+     */
+    void add_finding(std::string text) {
+        std::fprintf(stderr, "FINDING: %s\n", text.c_str());
+        _findings.push_back(std::move(text));
+    }
+
+    /**
+     * Write every result as a JSON document.
+     */
+    void write_json(std::ostream& out, std::string_view suite) const {
+        out << "{\n  \"suite\": ";
+        detail::write_json_string(out, suite);
+        out << ",\n  \"benchmarks\": [";
+        bool first = true;
+        for (auto& res : _results) {
+            out << (first ? "\n" : ",\n") << "    {\"name\": ";
+            first = false;
+            detail::write_json_string(out, res.name);
+            out << ", \"iterations\": " << res.iterations  //
+                << ", \"bytes_per_op\": " << res.bytes_per_op    //
+                << ", \"ns_per_op\": " << res.ns_per_op          //
+                << ", \"bytes_per_second\": " << res.bytes_per_sec;
+            for (auto& [key, value] : res.counters) {
+                out << ", ";
+                detail::write_json_string(out, key);
+                out << ": " << value;
+            }
+            out << "}";
+        }
+        out << "\n  ]";
+        if (!_findings.empty()) {
+            out << ",\n  \"findings\": [";
+            first = true;
+            for (auto& text : _findings) {
+                out << (first ? "\n    " : ",\n    ");
+                first = false;
+                detail::write_json_string(out, text);
+            }
+            out << "\n  ]";
+        }
+        out << "\n}\n";
+    }
+};
+
+}  // namespace neo::bench
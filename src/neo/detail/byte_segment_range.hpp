@@ -0,0 +1,92 @@
+#pragma once
+
+#include <neo/as_buffer.hpp>
+
+#include <neo/assert.hpp>
+#include <neo/iterator_concepts.hpp>
+#include <neo/iterator_facade.hpp>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace neo::detail {
+
+class byte_segment_sentinel {};
+
+/**
+ * A buffer range that views `size` bytes of an underlying buffer range,
+ * beginning `offset` bytes into the buffer referred to by `it`. The range is
+ * bounded by its byte count rather than by the underlying sentinel, so it
+ * never needs to compare against the end of the underlying range.
+ *
+ * This is the common implementation of bytewise segment views and buffer
+ * slices.
+ */
+template <typename Iter>
+class byte_segment_range {
+public:
+    using buffer_type = as_buffer_t<iter_reference_t<Iter>>;
+
+private:
+    Iter        _it;
+    std::size_t _offset = 0;
+    std::size_t _size   = 0;
+
+public:
+    class iterator : public iterator_facade<iterator> {
+        Iter        _it;
+        std::size_t _offset    = 0;
+        std::size_t _remaining = 0;
+
+        constexpr void _skip_exhausted() noexcept {
+            // Skip past buffers that have nothing left to offer
+            while (_remaining != 0 && as_buffer(*_it).size() == _offset) {
+                ++_it;
+                _offset = 0;
+            }
+        }
+
+    public:
+        constexpr iterator() = default;
+        constexpr iterator(Iter it, std::size_t offset, std::size_t remaining) noexcept
+            : _it(it)
+            , _offset(offset)
+            , _remaining(remaining) {
+            _skip_exhausted();
+        }
+
+        constexpr buffer_type dereference() const noexcept {
+            return as_buffer(as_buffer(*_it) + _offset, _remaining);
+        }
+
+        constexpr void increment() noexcept {
+            neo_assert(expects,
+                       _remaining != 0,
+                       "Advanced a past-the-end byte segment iterator",
+                       _remaining);
+            const auto n_here = (std::min)(as_buffer(*_it).size() - _offset, _remaining);
+            _remaining -= n_here;
+            _offset = 0;
+            ++_it;
+            _skip_exhausted();
+        }
+
+        constexpr bool operator==(const iterator& other) const noexcept {
+            return _remaining == other._remaining;
+        }
+        constexpr bool operator==(byte_segment_sentinel) const noexcept { return _remaining == 0; }
+    };
+
+    constexpr byte_segment_range() = default;
+    constexpr byte_segment_range(Iter it, std::size_t offset, std::size_t size) noexcept
+        : _it(it)
+        , _offset(offset)
+        , _size(size) {}
+
+    constexpr iterator              begin() const noexcept { return iterator(_it, _offset, _size); }
+    constexpr byte_segment_sentinel end() const noexcept { return {}; }
+
+    constexpr std::size_t byte_size() const noexcept { return _size; }
+};
+
+}  // namespace neo::detail
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+namespace neo::detail {
+
+/**
+ * The assumed size of a cache line. Atomics that are written by different
+ * threads are aligned to this to prevent false sharing.
+ *
+ * (std::hardware_destructive_interference_size is not used, as its value may
+ * differ between translation units compiled with different flags.)
+ */
+constexpr std::size_t cache_line_size = 64;
+
+}  // namespace neo::detail
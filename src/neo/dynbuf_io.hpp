@@ -2,6 +2,7 @@
 
 #include <neo/as_dynamic_buffer.hpp>
 #include <neo/buffer_algorithm/size.hpp>
+#include <neo/buffer_copy_accounting.hpp>
 #include <neo/buffer_range.hpp>
 #include <neo/dynamic_buffer.hpp>
 
@@ -15,10 +16,37 @@ class dynbuf_io {
     [[no_unique_address]] wrap_ref_member_t<DynBuf> _dyn_buf;
 
     std::size_t _read_area_size = as_dynamic_buffer(unref(_dyn_buf)).size();
+    /// The number of consumed bytes that are retained at the front of the buffer for a mark
+    std::size_t _pinned_size = 0;
+    /// The number of outstanding marks
+    std::size_t _n_marks = 0;
+
+    [[no_unique_address]] detail::buffer_copy_accounting<dynbuf_io> _copy_acct;
+
+    /// Call `fn` with the dynamic buffer, and account for the work that the buffer does
+    template <typename Fn>
+    constexpr void _update_buffer(Fn&& fn) noexcept(noexcept(fn(buffer()))) {
+        auto&&     buf    = buffer();
+        const auto before = detail::buffer_copy_stats_of(buf);
+        fn(buf);
+        _copy_acct.absorb(before, detail::buffer_copy_stats_of(buf));
+    }
 
     constexpr std::size_t _get_write_area_size() const noexcept {
         return as_dynamic_buffer(unref(const_cast<wrap_ref_member_t<DynBuf>&>(_dyn_buf))).size()
-            - _read_area_size;
+            - _pinned_size - _read_area_size;
+    }
+
+    /// The largest capacity that the storage behind the dynamic buffer has had, as far as is known
+    constexpr std::size_t _peak_storage_capacity() const noexcept {
+        decltype(auto) buf = buffer();
+        std::size_t    cap = detail::buffer_copy_stats_of(buf).peak_capacity;
+        // A container adaptor is made afresh by each call to buffer(), so its stats know nothing
+        // of earlier calls. Its current capacity is always known, though.
+        if constexpr (requires { buf.capacity(); }) {
+            cap = (std::max)(cap, static_cast<std::size_t>(buf.capacity()));
+        }
+        return cap;
     }
 
 public:
@@ -40,7 +68,7 @@ public:
 
     constexpr decltype(auto) next(std::size_t size) const noexcept {
         auto read_size = (std::min)(size, _read_area_size);
-        return buffer().data(0, read_size);
+        return buffer().data(_pinned_size, read_size);
     }
 
     constexpr void consume(std::size_t s) noexcept {
@@ -50,14 +78,19 @@ public:
                    s,
                    _read_area_size,
                    _get_write_area_size());
-        buffer().consume(s);
         _read_area_size -= s;
+        if (_n_marks == 0) {
+            _update_buffer([&](auto&& buf) noexcept { buf.consume(s); });
+        } else {
+            // Retain the bytes for the outstanding marks
+            _pinned_size += s;
+        }
     }
 
     constexpr decltype(auto) prepare(std::size_t size) noexcept(noexcept(buffer().grow(size))) {
         if (size <= _get_write_area_size()) {
             // There's enough room in the output area to just yield it
-            return buffer().data(_read_area_size, size);
+            return buffer().data(_pinned_size + _read_area_size, size);
         } else {
             // We need to expand the output area
             // Calc how much we can grow within the bounds of max_size():
@@ -67,8 +100,8 @@ public:
             // XXX: Allow user to tweak this as a library config option
             constexpr std::size_t max_alloc_size   = 1024 * 1024 * 16;
             const auto            capped_grow_size = (std::min)(max_alloc_size, grow_size);
-            buffer().grow(capped_grow_size);
-            return buffer().data(_read_area_size, _get_write_area_size());
+            _update_buffer([&](auto&& buf) { buf.grow(capped_grow_size); });
+            return buffer().data(_pinned_size + _read_area_size, _get_write_area_size());
         }
     }
 
@@ -79,12 +112,141 @@ public:
                    size,
                    _get_write_area_size());
         _read_area_size += size;
+        if constexpr (buffer_copy_accounting_enabled) {
+            _copy_acct.grown(size);
+            _copy_acct.observe(_read_area_size, _peak_storage_capacity());
+        }
+    }
+
+    /**
+     * Reserve `n` bytes of headroom in front of the read area, so that a header
+     * can be added with prepend() once the bytes that follow it are written.
+     * The buffer must be empty. Requires that the dynamic buffer supports
+     * headroom, as shifting_dynamic_buffer does.
+     */
+    constexpr void reserve_headroom(std::size_t n)  //
+        noexcept(noexcept(buffer().reserve_headroom(n)))
+        requires requires { buffer().reserve_headroom(n); }
+    {
+        neo_assert(expects,
+                   _read_area_size == 0 && _pinned_size == 0 && _get_write_area_size() == 0,
+                   "Headroom can only be reserved in an empty dynbuf_io",
+                   n,
+                   _read_area_size,
+                   _pinned_size,
+                   _get_write_area_size());
+        buffer().reserve_headroom(n);
+    }
+
+    /**
+     * The number of bytes that may be given to prepend().
+     */
+    constexpr std::size_t headroom() const noexcept requires requires { buffer().headroom(); } {
+        return _pinned_size == 0 ? buffer().headroom() : 0;
+    }
+
+    /**
+     * Ensure that at least `n` bytes can be given to prepare() without growing
+     * or shifting the storage, such as to later append a trailer. Requires that
+     * the dynamic buffer supports tailroom, as shifting_dynamic_buffer does.
+     */
+    constexpr void reserve_tailroom(std::size_t n)  //
+        noexcept(noexcept(buffer().reserve_tailroom(n)))
+        requires requires { buffer().reserve_tailroom(n); }
+    {
+        const auto write_area_size = _get_write_area_size();
+        if (write_area_size < n) {
+            _update_buffer([&](auto&& buf) { buf.reserve_tailroom(n - write_area_size); });
+        }
+    }
+
+    /**
+     * The number of bytes that may be given to prepare() without growing or
+     * shifting the storage.
+     */
+    constexpr std::size_t tailroom() const noexcept requires requires { buffer().tailroom(); } {
+        return _get_write_area_size() + buffer().tailroom();
     }
 
-    constexpr void shrink_uncommitted() noexcept { dynbuf_resize(buffer(), available()); }
+    /**
+     * Extend the read area at the front by `n` bytes taken from the headroom,
+     * and return the new bytes to be filled. Nothing in the read area is moved.
+     * Cannot be used while bytes are retained for a mark.
+     */
+    constexpr decltype(auto) prepend(std::size_t n) noexcept
+        requires requires { buffer().prepend(n); }
+    {
+        neo_assert(expects,
+                   _pinned_size == 0,
+                   "Cannot prepend to a dynbuf_io while it retains bytes for a mark",
+                   n,
+                   _pinned_size);
+        _read_area_size += n;
+        return buffer().prepend(n);
+    }
+
+    constexpr void shrink_uncommitted() noexcept {
+        dynbuf_resize(buffer(), _pinned_size + available());
+    }
     constexpr void clear() noexcept {
         dynbuf_clear(buffer());
         _read_area_size = 0;
+        _pinned_size    = 0;
+        _n_marks        = 0;
+    }
+
+    /**
+     * A saved read position of a dynbuf_io. See mark().
+     */
+    struct mark_type {
+        std::size_t position;
+    };
+
+    /**
+     * Save the current read position. While any mark is outstanding, consumed
+     * bytes are retained in the underlying buffer rather than being discarded,
+     * so that rewind() can return to the mark without copying. Every mark must
+     * eventually be passed to release().
+     */
+    [[nodiscard]] constexpr mark_type mark() noexcept {
+        ++_n_marks;
+        return mark_type{_pinned_size};
+    }
+
+    /**
+     * Return to a position previously saved with mark(). Bytes consumed since
+     * the mark become readable again. The mark remains outstanding.
+     */
+    constexpr void rewind(const mark_type& m) noexcept {
+        neo_assert(expects, _n_marks != 0, "rewind() called on a dynbuf_io with no marks");
+        neo_assert(expects,
+                   m.position <= _pinned_size,
+                   "Cannot rewind a dynbuf_io to a position ahead of its current position",
+                   m.position,
+                   _pinned_size);
+        _read_area_size += _pinned_size - m.position;
+        _pinned_size = m.position;
+    }
+
+    /**
+     * Discard a mark. Once no marks are outstanding, the bytes that were
+     * retained for them are consumed from the underlying buffer.
+     */
+    constexpr void release(const mark_type&) noexcept {
+        neo_assert(expects, _n_marks != 0, "release() called on a dynbuf_io with no marks");
+        --_n_marks;
+        if (_n_marks == 0) {
+            _update_buffer([&](auto&& buf) noexcept { buf.consume(_pinned_size); });
+            _pinned_size = 0;
+        }
+    }
+
+    /**
+     * The work done by the dynamic buffer on behalf of this object. See
+     * NEO_BUFFER_COPY_ACCOUNTING.
+     */
+    [[nodiscard]] constexpr buffer_copy_stats copy_stats() const noexcept {
+        return _copy_acct.stats();
     }
 };
 
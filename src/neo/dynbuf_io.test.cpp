@@ -2,12 +2,16 @@
 
 #include <neo/as_dynamic_buffer.hpp>
 #include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffer_source.hpp>
 #include <neo/fixed_dynamic_buffer.hpp>
+#include <neo/string_io.hpp>
 
 #include <neo/test_concept.hpp>
 
 #include <catch2/catch.hpp>
 
+NEO_TEST_CONCEPT(neo::rewindable_buffer_source<neo::dynbuf_io<std::string&>>);
+
 TEST_CASE("Create an IO adapter around std::string") {
     std::string str;
 
@@ -38,4 +42,86 @@ TEST_CASE("Grow a string with a WAY too large request") {
     std::string    str;
     neo::dynbuf_io dbuf{str};
     CHECK_NOTHROW(dbuf.prepare(std::numeric_limits<std::size_t>::max() - 92));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Rewind a dynbuf_io to a mark") {
+    std::string    str;
+    neo::dynbuf_io io{str};
+    io.commit(neo::buffer_copy(io.prepare(12), neo::const_buffer("Hello, world")));
+
+    io.consume(2);
+    auto m = io.mark();
+    io.consume(5);
+    CHECK(std::string_view(io.next(1024)) == "world");
+    // The consumed bytes are still held in the buffer
+    CHECK(str == "llo, world");
+
+    // Write more data while the mark is outstanding
+    io.commit(neo::buffer_copy(io.prepare(1), neo::const_buffer("!")));
+    CHECK(std::string_view(io.next(1024)) == "world!");
+
+    io.rewind(m);
+    CHECK(std::string_view(io.next(1024)) == "llo, world!");
+    CHECK(io.available() == 11);
+
+    // Consume again, then release the mark to discard the pinned bytes
+    io.consume(5);
+    io.release(m);
+    CHECK(str == "world!");
+    CHECK(std::string_view(io.next(1024)) == "world!");
+
+    // Consumption without a mark is immediate
+    io.consume(1);
+    CHECK(str == "orld!");
+}
+
+TEST_CASE("Nested dynbuf_io marks") {
+    std::string    str;
+    neo::dynbuf_io io{str};
+    io.commit(neo::buffer_copy(io.prepare(6), neo::const_buffer("abcdef")));
+
+    auto outer = io.mark();
+    io.consume(2);
+    auto inner = io.mark();
+    io.consume(2);
+    io.rewind(inner);
+    CHECK(std::string_view(io.next(1024)) == "cdef");
+    io.release(inner);
+    // The outer mark is still outstanding, so nothing was discarded
+    CHECK(str == "abcdef");
+    io.rewind(outer);
+    CHECK(std::string_view(io.next(1024)) == "abcdef");
+    io.consume(3);
+    io.release(outer);
+    CHECK(str == "def");
+}
+
+TEST_CASE("Prepend a header to a dynbuf_io after writing the payload") {
+    neo::shifting_string_dynbuf_io io;
+    io.reserve_headroom(2);
+    CHECK(io.headroom() == 2);
+
+    neo::buffer_copy(io, neo::const_buffer("Hello!"));
+    CHECK(io.read_area_view() == "Hello!");
+
+    auto hdr = io.prepend(2);
+    hdr[0]   = std::byte{0};
+    hdr[1]   = std::byte{'\x06'};
+    CHECK(io.available() == 8);
+    CHECK(io.read_area_view() == std::string_view("\x00\x06Hello!", 8));
+    CHECK(io.headroom() == 0);
+}
+
+TEST_CASE("Append a trailer to a dynbuf_io without moving the payload") {
+    neo::shifting_string_dynbuf_io io;
+    neo::buffer_copy(io, neo::const_buffer("Hello"));
+    io.reserve_tailroom(4);
+    CHECK(io.tailroom() >= 4);
+
+    const auto before = io.next(5);
+    auto       tail   = io.prepare(4);
+    neo::buffer_copy(tail, neo::const_buffer("!!!!"));
+    io.commit(4);
+    CHECK(io.next(5).data() == before.data());
+    CHECK(io.read_area_view() == "Hello!!!!");
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <neo/buffer_range.hpp>
+#include <neo/buffer_vector.hpp>
+#include <neo/buffers_cat.hpp>
+
+#include <neo/fwd.hpp>
+
+#include <cstddef>
+#include <memory>
+
+namespace neo {
+
+/**
+ * A `flat_buffer_sequence` is a `buffer_vector` that holds the non-empty
+ * buffers of some other buffer range, materialized so that walking them is a
+ * linear scan with no per-step dispatch. Use `buffers_flatten()` or
+ * `buffers_cat_flat()` to build one from other buffer ranges.
+ */
+template <typename BufferType,
+          std::size_t InlineCount = 16,
+          typename Allocator      = std::allocator<BufferType>>
+using flat_buffer_sequence = buffer_vector<BufferType, InlineCount, Allocator>;
+
+/**
+ * Materialize the given buffer range into a flat_buffer_sequence. Empty buffers
+ * are dropped.
+ */
+template <std::size_t InlineCount = 16, buffer_range Bufs>
+constexpr auto buffers_flatten(const Bufs& bufs) {
+    return flat_buffer_sequence<buffer_range_value_t<Bufs>, InlineCount>(bufs);
+}
+
+/**
+ * Concatenate the given buffer ranges and materialize the result into a single
+ * flat_buffer_sequence. This is preferable to `buffers_cat()` when many
+ * non-trivial ranges are joined and the result will be iterated repeatedly.
+ */
+template <std::size_t InlineCount = 16, buffer_range... Bufs>
+constexpr auto buffers_cat_flat(Bufs&&... bufs) {
+    return buffers_flatten<InlineCount>(buffers_cat(NEO_FWD(bufs)...));
+}
+
+}  // namespace neo
@@ -0,0 +1,77 @@
+#include <neo/flat_buffer_sequence.hpp>
+
+#include <neo/buffer_algorithm.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/static_buffer_vector.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std::literals;
+
+NEO_TEST_CONCEPT(neo::buffer_range<neo::flat_buffer_sequence<neo::const_buffer>>);
+NEO_TEST_CONCEPT(neo::mutable_buffer_range<neo::flat_buffer_sequence<neo::mutable_buffer>>);
+NEO_TEST_CONCEPT(
+    neo::random_access_iterator<neo::flat_buffer_sequence<neo::const_buffer>::iterator>);
+
+TEST_CASE("Create an empty flat sequence") {
+    neo::flat_buffer_sequence<neo::const_buffer> seq;
+    CHECK(seq.empty());
+    CHECK(seq.is_inline());
+    CHECK(neo::buffer_count(seq) == 0);
+    CHECK(neo::buffer_size(seq) == 0);
+}
+
+TEST_CASE("Spill a flat sequence onto the heap") {
+    neo::flat_buffer_sequence<neo::const_buffer, 2> seq;
+    seq.push_back(neo::const_buffer("foo"));
+    seq.push_back(neo::const_buffer("bar"));
+    CHECK(seq.is_inline());
+    seq.push_back(neo::const_buffer("baz"));
+    CHECK_FALSE(seq.is_inline());
+    CHECK(seq.size() == 3);
+    CHECK(neo::buffer_size(seq) == 9);
+
+    std::string out;
+    out.resize(9);
+    neo::buffer_copy(neo::as_buffer(out), seq);
+    CHECK(out == "foobarbaz");
+
+    // Copies and moves preserve the contents
+    auto copy = seq;
+    CHECK(copy.size() == 3);
+    auto moved = std::move(copy);
+    CHECK(moved.size() == 3);
+    CHECK(copy.size() == 0);
+    CHECK(moved[2].equals_string("baz"sv));
+}
+
+TEST_CASE("Flatten a buffer concatenation") {
+    neo::static_buffer_vector<neo::const_buffer, 4> vec;
+    vec.push_back(neo::const_buffer("one"));
+    vec.push_back(neo::const_buffer(""));
+    vec.push_back(neo::const_buffer("two"));
+
+    std::vector<neo::const_buffer> parts;
+    for (auto i = 0; i < 30; ++i) {
+        parts.push_back(neo::const_buffer("-"));
+    }
+
+    auto cat  = neo::buffers_cat(vec, parts, vec);
+    auto flat = neo::buffers_flatten(cat);
+    // The empty buffers are dropped
+    CHECK(flat.size() == 2 + 30 + 2);
+    CHECK(neo::buffer_size(flat) == neo::buffer_size(cat));
+
+    auto flat2 = neo::buffers_cat_flat(vec, parts, neo::const_buffer("end"));
+    CHECK(flat2.size() == 2 + 30 + 1);
+
+    std::string out;
+    out.resize(neo::buffer_size(flat2));
+    neo::buffer_copy(neo::as_buffer(out), flat2);
+    CHECK(out == "onetwo" + std::string(30, '-') + "end");
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffer_algorithm/transform.hpp>
+#include <neo/buffer_algorithm/transform_inplace.hpp>
+#include <neo/byte_array.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <neo/concepts.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace neo {
+
+namespace detail {
+
+/**
+ * Apply `word_fn` to each 8-byte word of `buf` and `byte_fn` to the remaining
+ * bytes. Words are loaded and stored with memcpy, so this is safe for any
+ * alignment, and compiles to plain (and often vectorized) word operations.
+ */
+template <typename WordFn, typename ByteFn>
+constexpr void swar_for_each(mutable_buffer buf, WordFn&& word_fn, ByteFn&& byte_fn) noexcept {
+    auto ptr  = buf.data();
+    auto stop = ptr + buf.size();
+#ifdef __cpp_lib_is_constant_evaluated
+    if (!std::is_constant_evaluated()) {
+        for (; stop - ptr >= 8; ptr += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, ptr, 8);
+            word = word_fn(word);
+            std::memcpy(ptr, &word, 8);
+        }
+    }
+#endif
+    for (; ptr != stop; ++ptr) {
+        *ptr = byte_fn(*ptr);
+    }
+}
+
+constexpr std::uint64_t swar_repeat(std::uint8_t b) noexcept {
+    return std::uint64_t(b) * 0x0101010101010101;
+}
+
+/**
+ * The high bit of each byte of the result is set if the corresponding byte of
+ * `w` is an ASCII character in [lo, hi].
+ */
+constexpr std::uint64_t swar_ascii_in_range(std::uint64_t w, char lo, char hi) noexcept {
+    constexpr auto high_bits = swar_repeat(0x80);
+    const auto     heptets   = w & ~high_bits;
+    const auto     ge_lo     = heptets + swar_repeat(std::uint8_t(0x80 - lo));
+    const auto     gt_hi     = heptets + swar_repeat(std::uint8_t(0x80 - hi - 1));
+    return ge_lo & ~gt_hi & ~w & high_bits;
+}
+
+/**
+ * Base for transformers that transform in place, also providing the two-buffer
+ * form required by `buffer_transformer`: the input is copied to the output and
+ * then transformed there.
+ */
+template <typename Derived>
+struct inplace_transformer_base {
+    constexpr simple_transform_result operator()(mutable_buffer out, const_buffer in) noexcept {
+        auto n = buffer_copy(out, in);
+        static_cast<Derived&>(*this)(mutable_buffer(out.data(), n));
+        return {n, n, false};
+    }
+};
+
+}  // namespace detail
+
+/**
+ * XOR each byte of a stream with a repeating key of `KeySize` bytes. The key
+ * position is kept between calls. This is its own inverse.
+ *
+ * For a key size that divides eight, eight bytes are transformed per step.
+ */
+template <std::size_t KeySize>
+class xor_mask_transformer
+    : public detail::inplace_transformer_base<xor_mask_transformer<KeySize>> {
+    static_assert(KeySize != 0, "xor_mask_transformer requires a non-empty key");
+
+    byte_array<KeySize> _key;
+    std::size_t         _offset = 0;
+
+public:
+    constexpr explicit xor_mask_transformer(byte_array<KeySize> key) noexcept
+        : _key(key) {}
+
+    using xor_mask_transformer::inplace_transformer_base::operator();
+
+    constexpr void operator()(mutable_buffer buf) noexcept {
+        if constexpr (8 % KeySize == 0) {
+            // Build a word of the key, rotated to begin at the current key position
+            std::uint64_t word_key = 0;
+            for (std::size_t i = 0; i < 8; ++i) {
+                const auto b = std::to_integer<std::uint64_t>(_key[(_offset + i) % KeySize]);
+                if constexpr (std::endian::native == std::endian::little) {
+                    word_key |= b << (8 * i);
+                } else {
+                    word_key |= b << (8 * (7 - i));
+                }
+            }
+            auto pos = _offset;
+            detail::swar_for_each(
+                buf,
+                [&](std::uint64_t w) { return w ^ word_key; },
+                [&](std::byte b) { return b ^ _key[pos++ % KeySize]; });
+            // Words keep the key position, so only the tail bytes have moved it
+            _offset = (_offset + buf.size()) % KeySize;
+        } else {
+            for (std::size_t i = 0; i != buf.size(); ++i) {
+                buf[i] ^= _key[_offset];
+                _offset = (_offset + 1) % KeySize;
+            }
+        }
+    }
+};
+
+template <std::size_t N>
+xor_mask_transformer(byte_array<N>) -> xor_mask_transformer<N>;
+
+template <std::size_t KeySize>
+constexpr bool buffer_transformer_is_inplace_v<xor_mask_transformer<KeySize>> = true;
+
+/**
+ * Unmasks (or masks) the payload of a WebSocket frame with its four-byte key.
+ */
+using websocket_mask_transformer = xor_mask_transformer<4>;
+
+/**
+ * Convert ASCII lowercase letters to uppercase. All other bytes are unchanged.
+ */
+struct ascii_upper_transformer : detail::inplace_transformer_base<ascii_upper_transformer> {
+    using inplace_transformer_base::operator();
+
+    constexpr void operator()(mutable_buffer buf) const noexcept {
+        detail::swar_for_each(
+            buf,
+            [](std::uint64_t w) { return w ^ (detail::swar_ascii_in_range(w, 'a', 'z') >> 2); },
+            [](std::byte b) {
+                return (b >= std::byte{'a'} && b <= std::byte{'z'}) ? b ^ std::byte{0x20} : b;
+            });
+    }
+};
+
+template <>
+constexpr bool buffer_transformer_is_inplace_v<ascii_upper_transformer> = true;
+
+/**
+ * Convert ASCII uppercase letters to lowercase. All other bytes are unchanged.
+ */
+struct ascii_lower_transformer : detail::inplace_transformer_base<ascii_lower_transformer> {
+    using inplace_transformer_base::operator();
+
+    constexpr void operator()(mutable_buffer buf) const noexcept {
+        detail::swar_for_each(
+            buf,
+            [](std::uint64_t w) { return w ^ (detail::swar_ascii_in_range(w, 'A', 'Z') >> 2); },
+            [](std::byte b) {
+                return (b >= std::byte{'A'} && b <= std::byte{'Z'}) ? b ^ std::byte{0x20} : b;
+            });
+    }
+};
+
+template <>
+constexpr bool buffer_transformer_is_inplace_v<ascii_lower_transformer> = true;
+
+}  // namespace neo
@@ -0,0 +1,146 @@
+#include <neo/inplace_transformers.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffer_algorithm/transform_inplace.hpp>
+#include <neo/string_io.hpp>
+#include <neo/transform_io.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cctype>
+#include <string>
+#include <vector>
+
+NEO_TEST_CONCEPT(neo::inplace_buffer_transformer<neo::websocket_mask_transformer>);
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::websocket_mask_transformer>);
+NEO_TEST_CONCEPT(neo::inplace_buffer_transformer<neo::ascii_upper_transformer>);
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::ascii_lower_transformer>);
+
+namespace {
+
+std::string make_test_string(std::size_t size) {
+    std::string str;
+    for (std::size_t i = 0; i < size; ++i) {
+        str.push_back(char(i * 37 + 11));
+    }
+    return str;
+}
+
+template <std::size_t N>
+std::string xor_reference(std::string str, neo::byte_array<N> key) {
+    for (std::size_t i = 0; i < str.size(); ++i) {
+        str[i] = char(str[i] ^ std::to_integer<char>(key[i % N]));
+    }
+    return str;
+}
+
+}  // namespace
+
+TEST_CASE("Mask a buffer with a key") {
+    const std::string original = make_test_string(100);
+
+    neo::byte_array<4> key = {std::byte{0x12}, std::byte{0x34}, std::byte{0x56}, std::byte{0x78}};
+
+    std::string str = original;
+    neo::websocket_mask_transformer{key}(neo::as_buffer(str));
+    CHECK(str == xor_reference(original, key));
+
+    // Masking again restores the original
+    neo::xor_mask_transformer{key}(neo::as_buffer(str));
+    CHECK(str == original);
+}
+
+TEST_CASE("Mask across buffers of odd sizes") {
+    const std::string original = make_test_string(257);
+
+    auto key_size = GENERATE(1, 3, 4, 8);
+
+    auto check_with_key = [&](auto key) {
+        std::string               str = original;
+        neo::xor_mask_transformer tr{key};
+        // Split the string into runs of 1, 2, 3, ... bytes so that the key
+        // position is different at the start of each buffer
+        std::vector<neo::mutable_buffer> bufs;
+        auto                             remaining = neo::as_buffer(str);
+        for (std::size_t len = 1; remaining.size() != 0; ++len) {
+            auto part = neo::as_buffer(remaining, len);
+            bufs.push_back(part);
+            remaining += part.size();
+        }
+        auto n = neo::buffer_transform_inplace(tr, bufs);
+        CHECK(n == original.size());
+        CHECK(str == xor_reference(original, key));
+    };
+
+    INFO("Key size " << key_size);
+    if (key_size == 1) {
+        check_with_key(neo::byte_array<1>{std::byte{0xa5}});
+    } else if (key_size == 3) {
+        check_with_key(neo::byte_array<3>{std::byte{1}, std::byte{2}, std::byte{3}});
+    } else if (key_size == 4) {
+        check_with_key(neo::byte_array<4>{std::byte{1}, std::byte{2}, std::byte{3}, std::byte{4}});
+    } else {
+        check_with_key(neo::byte_array<8>{std::byte{1},
+                                          std::byte{2},
+                                          std::byte{3},
+                                          std::byte{4},
+                                          std::byte{5},
+                                          std::byte{6},
+                                          std::byte{7},
+                                          std::byte{8}});
+    }
+}
+
+TEST_CASE("Mask through the two-buffer transformer interface") {
+    const std::string  original = make_test_string(40);
+    neo::byte_array<4> key      = {std::byte{9}, std::byte{8}, std::byte{7}, std::byte{6}};
+
+    neo::websocket_mask_transformer tr{key};
+
+    std::string out;
+    out.resize(original.size());
+    auto res = neo::buffer_transform(tr, neo::as_buffer(out), neo::as_buffer(original));
+    CHECK(res.bytes_read == original.size());
+    CHECK(res.bytes_written == original.size());
+    CHECK(out == xor_reference(original, key));
+}
+
+TEST_CASE("Convert ASCII case") {
+    // Every byte value, at every offset and length up to a few words
+    std::string all_bytes;
+    for (int c = 0; c < 256; ++c) {
+        all_bytes.push_back(char(c));
+    }
+
+    for (std::size_t offset = 0; offset < 9; ++offset) {
+        std::string upper = all_bytes;
+        std::string lower = all_bytes;
+        neo::ascii_upper_transformer{}(neo::as_buffer(upper) + offset);
+        neo::ascii_lower_transformer{}(neo::as_buffer(lower) + offset);
+        for (std::size_t i = 0; i < all_bytes.size(); ++i) {
+            const auto c           = static_cast<unsigned char>(all_bytes[i]);
+            const bool transformed = i >= offset && c < 128;
+            INFO("Offset " << offset << ", byte " << int(c));
+            CHECK(upper[i] == (transformed ? char(std::toupper(c)) : char(c)));
+            CHECK(lower[i] == (transformed ? char(std::tolower(c)) : char(c)));
+        }
+    }
+
+    std::string mixed = "Hello, World! This sentence is longer than a word.";
+    neo::ascii_upper_transformer{}(neo::as_buffer(mixed));
+    CHECK(mixed == "HELLO, WORLD! THIS SENTENCE IS LONGER THAN A WORD.");
+    neo::ascii_lower_transformer{}(neo::as_buffer(mixed));
+    CHECK(mixed == "hello, world! this sentence is longer than a word.");
+}
+
+TEST_CASE("Transform in place within a sink") {
+    neo::string_dynbuf_io      out;
+    neo::buffer_transform_sink upper_sink{out, neo::ascii_upper_transformer{}};
+
+    std::string str = "Transformed in the sink's own buffer";
+    neo::buffer_copy(upper_sink, neo::as_buffer(str));
+    out.shrink_uncommitted();
+    CHECK(out.read_area_view() == "TRANSFORMED IN THE SINK'S OWN BUFFER");
+}
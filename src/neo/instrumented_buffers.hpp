@@ -0,0 +1,429 @@
+#pragma once
+
+#include <neo/buffer_algorithm/size.hpp>
+#include <neo/buffer_sink.hpp>
+#include <neo/buffer_source.hpp>
+#include <neo/detail/cache_line.hpp>
+
+#include <neo/assert.hpp>
+#include <neo/fwd.hpp>
+#include <neo/ref_member.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace neo {
+
+/**
+ * The number of buckets in an io_size_histogram. Bucket zero counts sizes of
+ * zero, and bucket `i` counts sizes in [2^(i-1), 2^i). The last bucket also
+ * counts all larger sizes.
+ */
+constexpr std::size_t io_size_histogram_buckets = 33;
+
+/**
+ * A histogram of buffer sizes with power-of-two buckets.
+ */
+struct io_size_histogram {
+    std::array<std::uint64_t, io_size_histogram_buckets> counts{};
+
+    /// The index of the bucket that counts the given size
+    constexpr static std::size_t bucket_for(std::size_t size) noexcept {
+        return (std::min)(static_cast<std::size_t>(std::bit_width(size)),
+                          io_size_histogram_buckets - 1);
+    }
+
+    /// The smallest size counted by the given bucket
+    constexpr static std::size_t bucket_lower_bound(std::size_t bucket) noexcept {
+        return bucket == 0 ? 0 : std::size_t(1) << (bucket - 1);
+    }
+
+    /// The total number of sizes counted
+    constexpr std::uint64_t total() const noexcept {
+        std::uint64_t n = 0;
+        for (auto c : counts) {
+            n += c;
+        }
+        return n;
+    }
+};
+
+/**
+ * The statistics recorded by an io_instrumentation, as returned by
+ * io_instrumentation::snapshot(). "Request" refers to calls to `prepare()` of a
+ * sink or `next()` of a source, and "commit" refers to calls to `commit()` of a
+ * sink or `consume()` of a source.
+ */
+struct io_stats_snapshot {
+    /// The number of requests
+    std::uint64_t request_calls = 0;
+    /// The number of commits
+    std::uint64_t commit_calls = 0;
+    /// The total number of bytes committed
+    std::uint64_t bytes = 0;
+    /// The number of sampled requests that were granted fewer bytes than were requested
+    std::uint64_t short_grants = 0;
+    /// The number of requests that were sampled into the histograms and timings
+    std::uint64_t sampled_requests = 0;
+    /// The number of commits that were sampled into the histograms and timings
+    std::uint64_t sampled_commits = 0;
+
+    /// The sizes requested, for sampled requests
+    io_size_histogram requested;
+    /// The sizes granted, for sampled requests
+    io_size_histogram granted;
+    /// The sizes committed, for sampled commits
+    io_size_histogram committed;
+
+    /// Time spent in sampled requests, if timing is enabled
+    std::chrono::nanoseconds request_time{0};
+    /// Time spent in sampled commits, if timing is enabled
+    std::chrono::nanoseconds commit_time{0};
+};
+
+struct io_instrumentation_options {
+    /// Record histograms and timings for one in every `sample_interval` calls on each thread
+    std::uint32_t sample_interval = 1;
+    /// Measure the time spent in sampled calls
+    bool measure_time = false;
+};
+
+namespace detail {
+
+/**
+ * The counters of one thread for one io_instrumentation. Only the owning thread
+ * writes to them, so an update is a plain load and store rather than an atomic
+ * read-modify-write. They are atomics only so that snapshot() may read them
+ * from another thread.
+ */
+struct alignas(cache_line_size) io_stats_shard {
+    using counter = std::atomic<std::uint64_t>;
+
+    /// The thread that writes to this shard
+    std::thread::id owner = std::this_thread::get_id();
+    /// The number of calls left until the next sampled call. Only used by the owner.
+    std::uint32_t calls_until_sample = 0;
+
+    counter request_calls{0};
+    counter commit_calls{0};
+    counter bytes{0};
+    counter short_grants{0};
+    counter sampled_requests{0};
+    counter sampled_commits{0};
+    counter request_ns{0};
+    counter commit_ns{0};
+
+    std::array<counter, io_size_histogram_buckets> requested{};
+    std::array<counter, io_size_histogram_buckets> granted{};
+    std::array<counter, io_size_histogram_buckets> committed{};
+
+    static void bump(counter& c, std::uint64_t n = 1) noexcept {
+        c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+};
+
+/// A thread's cached pointer to its shard of an io_instrumentation
+struct io_stats_shard_cache_entry {
+    std::uint64_t   instr_id = 0;
+    io_stats_shard* shard    = nullptr;
+};
+
+/**
+ * Each thread caches the shards of the last few io_instrumentation objects
+ * that it has used, keyed by their ID.
+ */
+inline std::array<io_stats_shard_cache_entry, 4>& io_stats_shard_cache() noexcept {
+    thread_local std::array<io_stats_shard_cache_entry, 4> cache{};
+    return cache;
+}
+
+inline std::uint64_t next_io_instrumentation_id() noexcept {
+    static std::atomic<std::uint64_t> next_id{1};
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace detail
+
+/**
+ * Collects statistics about the calls made through any number of
+ * instrumented_buffers, from any number of threads.
+ *
+ * Call and byte counts are always recorded. Size histograms, short grants, and
+ * timings are recorded for a sample of calls chosen by `sample_interval`, and
+ * cost nothing for the calls that are not sampled.
+ *
+ * Each thread records into its own set of counters, which is found through a
+ * thread-local cache, so recording a call involves no locks, atomic
+ * read-modify-writes, or cache lines shared with other threads. (A thread
+ * takes a lock the first time that it records into an io_instrumentation.)
+ * The counters of every thread are only summed when snapshot() is called.
+ */
+class io_instrumentation {
+    io_instrumentation_options _opts;
+
+    /// Identifies this object in the thread-local shard caches. Never reused.
+    std::uint64_t _id = detail::next_io_instrumentation_id();
+
+    mutable std::mutex                                   _shards_mutex;
+    std::vector<std::unique_ptr<detail::io_stats_shard>> _shards;
+    /// The totals at the last snapshot_and_reset(), which are subtracted from later snapshots
+    io_stats_snapshot _baseline;
+
+    /// Get the calling thread's shard. The first call on a thread may throw, since the shard is
+    /// created under a lock.
+    detail::io_stats_shard& _shard() {
+        auto& entry = detail::io_stats_shard_cache()[_id % detail::io_stats_shard_cache().size()];
+        if (entry.instr_id == _id) {
+            return *entry.shard;
+        }
+        entry = {_id, &_find_or_add_shard()};
+        return *entry.shard;
+    }
+
+    detail::io_stats_shard& _find_or_add_shard() {
+        std::lock_guard lk{_shards_mutex};
+        const auto      this_thread = std::this_thread::get_id();
+        // A thread whose cache entry was evicted finds its existing shard here. (So may a new
+        // thread that is given the ID of one that has exited, which is harmless.)
+        for (auto& shard : _shards) {
+            if (shard->owner == this_thread) {
+                return *shard;
+            }
+        }
+        return *_shards.emplace_back(std::make_unique<detail::io_stats_shard>());
+    }
+
+    /// As _shard(), but returns null rather than throwing
+    detail::io_stats_shard* _try_shard() noexcept {
+        try {
+            return &_shard();
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    bool _should_sample(detail::io_stats_shard& shard) const noexcept {
+        if (shard.calls_until_sample == 0) {
+            shard.calls_until_sample = _opts.sample_interval - 1;
+            return true;
+        }
+        --shard.calls_until_sample;
+        return false;
+    }
+
+    /// Sum the counters of every thread. Requires the shards mutex.
+    io_stats_snapshot _totals() const noexcept {
+        io_stats_snapshot snap;
+        auto              load = [](const std::atomic<std::uint64_t>& c) {
+            return c.load(std::memory_order_relaxed);
+        };
+        std::uint64_t request_ns = 0;
+        std::uint64_t commit_ns  = 0;
+        for (auto& shard : _shards) {
+            snap.request_calls += load(shard->request_calls);
+            snap.commit_calls += load(shard->commit_calls);
+            snap.bytes += load(shard->bytes);
+            snap.short_grants += load(shard->short_grants);
+            snap.sampled_requests += load(shard->sampled_requests);
+            snap.sampled_commits += load(shard->sampled_commits);
+            request_ns += load(shard->request_ns);
+            commit_ns += load(shard->commit_ns);
+            for (std::size_t i = 0; i < io_size_histogram_buckets; ++i) {
+                snap.requested.counts[i] += load(shard->requested[i]);
+                snap.granted.counts[i] += load(shard->granted[i]);
+                snap.committed.counts[i] += load(shard->committed[i]);
+            }
+        }
+        snap.request_time = std::chrono::nanoseconds(request_ns);
+        snap.commit_time  = std::chrono::nanoseconds(commit_ns);
+        return snap;
+    }
+
+    static io_stats_snapshot _difference(io_stats_snapshot a, const io_stats_snapshot& b) noexcept {
+        a.request_calls -= b.request_calls;
+        a.commit_calls -= b.commit_calls;
+        a.bytes -= b.bytes;
+        a.short_grants -= b.short_grants;
+        a.sampled_requests -= b.sampled_requests;
+        a.sampled_commits -= b.sampled_commits;
+        for (std::size_t i = 0; i < io_size_histogram_buckets; ++i) {
+            a.requested.counts[i] -= b.requested.counts[i];
+            a.granted.counts[i] -= b.granted.counts[i];
+            a.committed.counts[i] -= b.committed.counts[i];
+        }
+        a.request_time -= b.request_time;
+        a.commit_time -= b.commit_time;
+        return a;
+    }
+
+public:
+    io_instrumentation() = default;
+
+    explicit io_instrumentation(io_instrumentation_options opts) noexcept
+        : _opts(opts) {
+        neo_assert(expects,
+                   opts.sample_interval != 0,
+                   "io_instrumentation sample interval must be non-zero");
+    }
+
+    [[nodiscard]] const io_instrumentation_options& options() const noexcept { return _opts; }
+
+    /**
+     * Call `fn()` to request `requested` bytes, recording the request. `fn`
+     * returns the buffers that were granted, which are returned.
+     */
+    template <typename Fn>
+    decltype(auto) record_request(std::size_t requested, Fn&& fn) {
+        auto& shard = _shard();
+        detail::io_stats_shard::bump(shard.request_calls);
+        if (!_should_sample(shard)) {
+            return fn();
+        }
+        const auto     start   = _opts.measure_time ? std::chrono::steady_clock::now()
+                                                    : std::chrono::steady_clock::time_point();
+        decltype(auto) bufs    = fn();
+        const auto     granted = buffer_size(bufs);
+        if (_opts.measure_time) {
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            detail::io_stats_shard::bump(
+                shard.request_ns,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+        if (granted < requested) {
+            detail::io_stats_shard::bump(shard.short_grants);
+        }
+        detail::io_stats_shard::bump(shard.sampled_requests);
+        detail::io_stats_shard::bump(shard.requested[io_size_histogram::bucket_for(requested)]);
+        detail::io_stats_shard::bump(shard.granted[io_size_histogram::bucket_for(granted)]);
+        return bufs;
+    }
+
+    /**
+     * Call `fn()` to commit `n` bytes, recording the commit.
+     *
+     * If `fn()` does not throw, neither does this. Should the calling thread's
+     * counters then fail to be created, the commit is made without being
+     * recorded.
+     */
+    template <typename Fn>
+    void record_commit(std::size_t n, Fn&& fn) noexcept(noexcept(fn())) {
+        detail::io_stats_shard* shard_ptr = nullptr;
+        if constexpr (noexcept(fn())) {
+            shard_ptr = _try_shard();
+            if (!shard_ptr) {
+                fn();
+                return;
+            }
+        } else {
+            shard_ptr = &_shard();
+        }
+        auto& shard = *shard_ptr;
+        detail::io_stats_shard::bump(shard.commit_calls);
+        detail::io_stats_shard::bump(shard.bytes, n);
+        if (!_should_sample(shard)) {
+            fn();
+            return;
+        }
+        if (_opts.measure_time) {
+            const auto start   = std::chrono::steady_clock::now();
+            fn();
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            detail::io_stats_shard::bump(
+                shard.commit_ns,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        } else {
+            fn();
+        }
+        detail::io_stats_shard::bump(shard.sampled_commits);
+        detail::io_stats_shard::bump(shard.committed[io_size_histogram::bucket_for(n)]);
+    }
+
+    /**
+     * Sum the counters of every thread. The counters continue to be updated
+     * while the snapshot is taken, so calls made concurrently may or may not be
+     * included.
+     */
+    [[nodiscard]] io_stats_snapshot snapshot() const noexcept {
+        std::lock_guard lk{_shards_mutex};
+        return _difference(_totals(), _baseline);
+    }
+
+    /**
+     * Take a snapshot and start counting again from zero, such as to aggregate
+     * the statistics for each period of time. Each call made concurrently is
+     * counted in exactly one of the periods. (The counters are not written, so
+     * this does not race with the threads that own them.)
+     */
+    io_stats_snapshot snapshot_and_reset() noexcept {
+        std::lock_guard lk{_shards_mutex};
+        auto            totals = _totals();
+        auto            snap   = _difference(totals, _baseline);
+        _baseline              = totals;
+        return snap;
+    }
+};
+
+/**
+ * Wraps a buffer_sink or buffer_source and records every call made through it
+ * in an io_instrumentation. Unlike counting_buffers, no user code is called on
+ * each commit: the statistics are read later with
+ * io_instrumentation::snapshot().
+ */
+template <typename Bufs>
+requires(buffer_sink<Bufs> || buffer_source<Bufs>)  //
+    class instrumented_buffers {
+public:
+    using stream_type = std::remove_cvref_t<Bufs>;
+
+private:
+    [[no_unique_address]] wrap_ref_member_t<Bufs> _bufs;
+
+    io_instrumentation* _instr;
+
+public:
+    constexpr explicit instrumented_buffers(Bufs&& s, io_instrumentation& instr) noexcept(
+        std::is_nothrow_constructible_v<wrap_ref_member_t<Bufs>, Bufs>)
+        : _bufs(NEO_FWD(s))
+        , _instr(&instr) {}
+
+    NEO_DECL_UNREF_GETTER(buffers, _bufs);
+    NEO_DECL_REF_REBINDER(rebind_buffers, Bufs, _bufs);
+
+    [[nodiscard]] io_instrumentation& instrumentation() const noexcept { return *_instr; }
+
+    decltype(auto) prepare(std::size_t s) requires buffer_sink<Bufs> {
+        return _instr->record_request(s, [&]() -> decltype(auto) { return buffers().prepare(s); });
+    }
+
+    decltype(auto) next(std::size_t s) requires buffer_source<Bufs> {
+        return _instr->record_request(s, [&]() -> decltype(auto) { return buffers().next(s); });
+    }
+
+    void commit(std::size_t s) noexcept(noexcept(buffers().commit(s)))
+        requires buffer_sink<Bufs> {
+        _instr->record_commit(s, [&]() noexcept(noexcept(buffers().commit(s))) {
+            buffers().commit(s);
+        });
+    }
+
+    void consume(std::size_t s) noexcept(noexcept(buffers().consume(s)))
+        requires buffer_source<Bufs> {
+        _instr->record_commit(s, [&]() noexcept(noexcept(buffers().consume(s))) {
+            buffers().consume(s);
+        });
+    }
+};
+
+template <typename S>
+explicit instrumented_buffers(S&&, io_instrumentation&) -> instrumented_buffers<S>;
+
+}  // namespace neo
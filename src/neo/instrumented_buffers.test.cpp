@@ -0,0 +1,138 @@
+#include <neo/instrumented_buffers.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffers_consumer.hpp>
+#include <neo/string_io.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+NEO_TEST_CONCEPT(neo::buffer_sink<neo::instrumented_buffers<neo::string_dynbuf_io&>>);
+NEO_TEST_CONCEPT(neo::buffer_source<neo::instrumented_buffers<neo::string_dynbuf_io&>>);
+// Without an io_instrumentation there would be nothing to record into
+static_assert(!std::is_default_constructible_v<neo::instrumented_buffers<neo::string_dynbuf_io&>>);
+static_assert(noexcept(std::declval<neo::instrumented_buffers<neo::string_dynbuf_io&>&>().commit(1)));
+
+TEST_CASE("Histogram buckets") {
+    CHECK(neo::io_size_histogram::bucket_for(0) == 0);
+    CHECK(neo::io_size_histogram::bucket_for(1) == 1);
+    CHECK(neo::io_size_histogram::bucket_for(2) == 2);
+    CHECK(neo::io_size_histogram::bucket_for(3) == 2);
+    CHECK(neo::io_size_histogram::bucket_for(4096) == 13);
+    CHECK(neo::io_size_histogram::bucket_for(std::size_t(-1)) == 32);
+    CHECK(neo::io_size_histogram::bucket_lower_bound(13) == 4096);
+}
+
+TEST_CASE("Record the calls made to a sink") {
+    neo::io_instrumentation   instr;
+    neo::string_dynbuf_io     out;
+    neo::instrumented_buffers sink{out, instr};
+
+    neo::buffer_copy(sink, neo::as_buffer(std::string("Hello, world!")));
+    neo::buffer_copy(sink, neo::as_buffer(std::string("!")));
+
+    // buffer_copy() makes one more request to find that the input has ended
+    auto snap = instr.snapshot();
+    CHECK(snap.request_calls == 4);
+    CHECK(snap.commit_calls == 2);
+    CHECK(snap.bytes == 14);
+    CHECK(snap.sampled_commits == 2);
+    CHECK(snap.requested.total() == 4);
+    CHECK(snap.short_grants == 0);
+    CHECK(snap.committed.counts[neo::io_size_histogram::bucket_for(13)] == 1);
+    CHECK(snap.committed.counts[neo::io_size_histogram::bucket_for(1)] == 1);
+    CHECK(snap.request_time.count() == 0);
+}
+
+TEST_CASE("Find short reads from a source") {
+    std::string                    a    = "abc";
+    std::string                    b    = "defgh";
+    std::vector<neo::const_buffer> bufs = {neo::as_buffer(a), neo::as_buffer(b)};
+    neo::buffers_consumer          in{bufs};
+
+    neo::io_instrumentation   instr;
+    neo::instrumented_buffers src{in, instr};
+
+    neo::string_dynbuf_io out;
+    neo::buffer_copy(out, src);
+    CHECK(out.read_area_view() == "abcdefgh");
+
+    auto snap = instr.snapshot();
+    CHECK(snap.bytes == 8);
+    CHECK(snap.commit_calls == 2);
+    // Every request was for more than the source could give in one buffer
+    CHECK(snap.short_grants == snap.sampled_requests);
+    CHECK(snap.granted.counts[neo::io_size_histogram::bucket_for(3)] == 1);
+
+    auto reset = instr.snapshot_and_reset();
+    CHECK(reset.bytes == 8);
+    CHECK(instr.snapshot().bytes == 0);
+    CHECK(instr.snapshot().granted.total() == 0);
+
+    in = neo::buffers_consumer{bufs};
+    neo::buffer_copy(out, src);
+    CHECK(instr.snapshot().bytes == 8);
+}
+
+TEST_CASE("Sample and time a subset of calls") {
+    neo::io_instrumentation instr{neo::io_instrumentation_options{
+        .sample_interval = 4,
+        .measure_time    = true,
+    }};
+    neo::string_dynbuf_io     out;
+    neo::instrumented_buffers sink{out, instr};
+
+    for (int i = 0; i < 100; ++i) {
+        neo::buffer_copy(sink, neo::as_buffer(std::string("x")));
+    }
+    auto snap = instr.snapshot();
+    CHECK(snap.commit_calls == 100);
+    CHECK(snap.bytes == 100);
+    CHECK(snap.request_calls == 200);
+    CHECK(snap.sampled_commits + snap.sampled_requests == 75);
+    CHECK(snap.committed.total() == snap.sampled_commits);
+}
+
+TEST_CASE("Record from many threads") {
+    neo::io_instrumentation instr;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            neo::string_dynbuf_io     out;
+            neo::instrumented_buffers sink{out, instr};
+            for (int i = 0; i < 1000; ++i) {
+                neo::buffer_copy(sink, neo::as_buffer(std::string("abcd")));
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    auto snap = instr.snapshot();
+    CHECK(snap.commit_calls == 4000);
+    CHECK(snap.bytes == 16000);
+}
+
+TEST_CASE("Record into several instrumentations from one thread") {
+    // More than the thread caches, to force shards to be looked up again
+    std::vector<neo::io_instrumentation> instrs(9);
+    neo::string_dynbuf_io                out;
+    for (int round = 0; round < 3; ++round) {
+        for (auto& instr : instrs) {
+            neo::instrumented_buffers sink{out, instr};
+            neo::buffer_copy(sink, neo::as_buffer(std::string("ab")));
+        }
+    }
+    for (auto& instr : instrs) {
+        CHECK(instr.snapshot().bytes == 6);
+    }
+}
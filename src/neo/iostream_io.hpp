@@ -106,6 +106,16 @@ public:
                    buffer().available());
         buffer().consume(s);
     }
+
+    using mark_type = typename dynbuf_io<DynBuffer>::mark_type;
+
+    /**
+     * Save the current read position. Bytes read from the stream after the mark
+     * are retained in the buffer until the mark is released. See dynbuf_io::mark().
+     */
+    [[nodiscard]] mark_type mark() noexcept requires is_istream { return buffer().mark(); }
+    void rewind(const mark_type& m) noexcept requires is_istream { buffer().rewind(m); }
+    void release(const mark_type& m) noexcept requires is_istream { buffer().release(m); }
 };
 
 template <typename S, typename B>
@@ -11,6 +11,7 @@
 NEO_TEST_CONCEPT(neo::buffer_sink<neo::iostream_io<std::stringstream>>);
 NEO_TEST_CONCEPT(neo::buffer_sink<neo::iostream_io<std::ostream>>);
 NEO_TEST_CONCEPT(neo::buffer_source<neo::iostream_io<std::istream>>);
+NEO_TEST_CONCEPT(neo::rewindable_buffer_source<neo::iostream_io<std::istream>>);
 
 TEST_CASE("iostream IO") {
     std::stringstream strm;
@@ -42,3 +43,20 @@ TEST_CASE("iostream IO") {
     buf = source.next(5);
     CHECK(std::string_view(buf) == "Hello");
 }
+
+TEST_CASE("Rewind an istream source") {
+    std::stringstream strm{"Hello, world!"};
+    neo::iostream_io  source{strm};
+
+    CHECK(std::string_view(source.next(5)) == "Hello");
+    auto m = source.mark();
+    source.consume(5);
+    // Read more from the stream while the mark is outstanding
+    CHECK(std::string_view(source.next(8)) == ", world!");
+    source.consume(8);
+    source.rewind(m);
+    CHECK(std::string_view(source.next(100)) == "Hello, world!");
+    source.consume(7);
+    source.release(m);
+    CHECK(std::string_view(source.next(100)) == "world!");
+}
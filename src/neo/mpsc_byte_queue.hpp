@@ -0,0 +1,296 @@
+#pragma once
+
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/detail/atomic_wait.hpp>
+#include <neo/detail/cache_line.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <neo/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+namespace neo {
+
+/**
+ * A multi-producer/single-consumer queue of bytes. Any number of threads may
+ * reserve space in the queue, write into it, and commit it, in any order. A
+ * single consumer thread reads the committed bytes through the `source()` end,
+ * which is a `buffer_source`.
+ *
+ * Producers claim space with a single atomic fetch-add on a shared index, so
+ * writers never wait on one another. Each reservation becomes a record with a
+ * small header, and the consumer only sees records up to the first one that
+ * has not yet been committed. Bytes from different reservations are never
+ * interleaved.
+ *
+ * The state of each record is kept in a small table beside the ring, with one
+ * byte for each possible record position. The consumer resets a record's state
+ * as it releases it, so a record that has not been written yet always reads as
+ * uncommitted, and payload bytes are never written a second time. Waiting
+ * threads are only notified if there are any.
+ */
+class mpsc_byte_queue {
+    /// Every record begins on a multiple of this alignment
+    constexpr static std::size_t _record_align = 8;
+
+    struct record_header {
+        std::uint32_t length;
+        /// Keeps payloads aligned to _record_align
+        std::uint32_t reserved_;
+    };
+
+    static_assert(sizeof(record_header) == _record_align);
+
+    enum record_state : std::uint8_t {
+        /// Not yet reserved, or reserved but not yet committed
+        pending = 0,
+        committed,
+        /// Unused space at the end of the ring that should be skipped
+        padding,
+        /// The end of the stream, written by close()
+        closed,
+    };
+
+    std::unique_ptr<std::byte[]> _storage;
+    /// One record_state for every _record_align bytes of _storage
+    std::unique_ptr<std::uint8_t[]> _states;
+    std::size_t                     _capacity;
+
+    alignas(detail::cache_line_size) std::atomic<std::size_t> _reserve_idx{0};
+
+    /// The consumer, if it is blocked waiting for a record to be committed
+    alignas(detail::cache_line_size) detail::atomic_waiters _data_waiters;
+
+    alignas(detail::cache_line_size) std::atomic<std::size_t> _read_idx{0};
+    std::size_t _read_offset = 0;
+    /// Producers blocked waiting for the consumer to release space
+    detail::atomic_waiters _space_waiters;
+
+    constexpr static std::size_t _record_size(std::size_t payload_size) noexcept {
+        return (sizeof(record_header) + payload_size + _record_align - 1) & ~(_record_align - 1);
+    }
+
+    record_header* _header_at(std::size_t idx) const noexcept {
+        return reinterpret_cast<record_header*>(_storage.get() + (idx & (_capacity - 1)));
+    }
+
+    std::atomic_ref<std::uint8_t> _state_at(std::size_t idx) const noexcept {
+        return std::atomic_ref<std::uint8_t>(_states[(idx & (_capacity - 1)) / _record_align]);
+    }
+
+    /// Set the state of the record at `pos`, and wake the consumer if it is waiting for it
+    void _publish(std::size_t pos, record_state state) noexcept {
+        _state_at(pos).store(state, std::memory_order_release);
+        _data_waiters.notify_one(_state_at(pos));
+    }
+
+    void _wait_for_space(std::size_t pos, std::size_t size) noexcept {
+        auto r_idx = _read_idx.load(std::memory_order_acquire);
+        while (pos + size - r_idx > _capacity) {
+            _space_waiters.wait(_read_idx, r_idx);
+            r_idx = _read_idx.load(std::memory_order_acquire);
+        }
+    }
+
+    std::size_t _claim(std::uint32_t length, record_state state) noexcept {
+        const auto size = _record_size(length);
+        while (true) {
+            const auto pos    = _reserve_idx.fetch_add(size, std::memory_order_relaxed);
+            const auto offset = pos & (_capacity - 1);
+            _wait_for_space(pos, size);
+            auto hdr = _header_at(pos);
+            if (offset + size <= _capacity) {
+                hdr->length = length;
+                if (state != pending) {
+                    _publish(pos, state);
+                }
+                return pos;
+            }
+            // The record would wrap around the end of the ring, so it would not
+            // be contiguous. Give the claimed space up as padding, and try again.
+            hdr->length = static_cast<std::uint32_t>(size - sizeof(record_header));
+            _publish(pos, padding);
+        }
+    }
+
+    /// Release the record at the read position back to the producers
+    void _release_front(record_header* hdr) noexcept {
+        const auto r_idx = _read_idx.load(std::memory_order_relaxed);
+        _state_at(r_idx).store(pending, std::memory_order_relaxed);
+        _read_offset = 0;
+        _read_idx.store(r_idx + _record_size(hdr->length), std::memory_order_release);
+        _space_waiters.notify_all(_read_idx);
+    }
+
+    /**
+     * Find the first record with bytes to read, releasing any padding or empty
+     * records before it. Returns null if no committed bytes are available.
+     */
+    record_header* _front() noexcept {
+        while (true) {
+            const auto r_idx = _read_idx.load(std::memory_order_relaxed);
+            const auto state = _state_at(r_idx).load(std::memory_order_acquire);
+            if (state == pending || state == closed) {
+                return nullptr;
+            }
+            auto hdr = _header_at(r_idx);
+            if (state == committed && _read_offset != hdr->length) {
+                return hdr;
+            }
+            _release_front(hdr);
+        }
+    }
+
+public:
+    /**
+     * Create a queue that can hold at least `min_capacity` bytes, including
+     * record headers. The capacity is rounded up to a power of two.
+     */
+    explicit mpsc_byte_queue(std::size_t min_capacity)
+        : _capacity(std::bit_ceil((std::max)(min_capacity, 2 * sizeof(record_header)))) {
+        _storage.reset(new std::byte[_capacity]);
+        _states.reset(new std::uint8_t[_capacity / _record_align]());
+    }
+
+    mpsc_byte_queue(const mpsc_byte_queue&) = delete;
+    mpsc_byte_queue& operator=(const mpsc_byte_queue&) = delete;
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return _capacity; }
+
+    /**
+     * The largest number of bytes that can be reserved at once.
+     */
+    [[nodiscard]] std::size_t max_reserve_size() const noexcept {
+        return (std::min)(_capacity - sizeof(record_header),
+                          std::size_t(std::numeric_limits<std::uint32_t>::max()));
+    }
+
+    /**
+     * Space reserved by a producer. Write into `buffer()`, then pass the
+     * reservation to `commit()`.
+     */
+    class reservation {
+        friend class mpsc_byte_queue;
+        record_header* _header = nullptr;
+        std::size_t    _pos    = 0;
+
+        explicit reservation(record_header* h, std::size_t pos) noexcept
+            : _header(h)
+            , _pos(pos) {}
+
+    public:
+        reservation() = default;
+
+        [[nodiscard]] mutable_buffer buffer() const noexcept {
+            return mutable_buffer(reinterpret_cast<std::byte*>(_header + 1), _header->length);
+        }
+    };
+
+    /**
+     * Reserve `n` contiguous bytes in the queue. If the queue is full, blocks
+     * until the consumer releases enough space. May be called from any thread.
+     */
+    [[nodiscard]] reservation reserve(std::size_t n) noexcept {
+        neo_assert(expects,
+                   n <= max_reserve_size(),
+                   "Reservation is too large for the mpsc_byte_queue",
+                   n,
+                   max_reserve_size());
+        const auto pos = _claim(static_cast<std::uint32_t>(n), pending);
+        return reservation(_header_at(pos), pos);
+    }
+
+    /**
+     * Make the bytes of a reservation available to the consumer. Reservations
+     * may be committed in any order, but the consumer will not read past one
+     * that is not yet committed.
+     */
+    void commit(const reservation& r) noexcept { _publish(r._pos, committed); }
+
+    /**
+     * Copy `buf` into the queue as a single record.
+     */
+    void write(const_buffer buf) noexcept {
+        auto r = reserve(buf.size());
+        buffer_copy(r.buffer(), buf);
+        commit(r);
+    }
+
+    /**
+     * Mark the end of the stream. Should be called after every other
+     * reservation has been made.
+     */
+    void close() noexcept { _claim(0, closed); }
+
+    /**
+     * The consumer end of a queue. Only one thread may read from a queue.
+     */
+    class source_type {
+        mpsc_byte_queue* _queue;
+
+    public:
+        explicit source_type(mpsc_byte_queue& q) noexcept
+            : _queue(&q) {}
+
+        /**
+         * Obtain up to `n` committed bytes. The returned buffer will not span
+         * more than one record, so it may be smaller than what is available.
+         */
+        [[nodiscard]] const_buffer next(std::size_t n) noexcept {
+            auto hdr = _queue->_front();
+            if (!hdr) {
+                return const_buffer();
+            }
+            auto payload = const_buffer(reinterpret_cast<const std::byte*>(hdr + 1), hdr->length);
+            return as_buffer(payload + _queue->_read_offset, n);
+        }
+
+        void consume(std::size_t n) noexcept {
+            while (n != 0) {
+                auto hdr = _queue->_front();
+                neo_assert(expects,
+                           hdr != nullptr,
+                           "Consumed more bytes than are available in an mpsc_byte_queue",
+                           n);
+                const auto take = (std::min)(n, hdr->length - _queue->_read_offset);
+                _queue->_read_offset += take;
+                n -= take;
+                if (_queue->_read_offset == hdr->length) {
+                    _queue->_release_front(hdr);
+                }
+            }
+        }
+
+        /**
+         * Block until committed bytes are available, or the queue is closed.
+         * Returns `false` if the end of the stream has been reached.
+         */
+        bool wait_readable() noexcept {
+            while (true) {
+                if (_queue->_front()) {
+                    return true;
+                }
+                const auto r_idx = _queue->_read_idx.load(std::memory_order_relaxed);
+                const auto state = _queue->_state_at(r_idx).load(std::memory_order_acquire);
+                if (state == closed) {
+                    return false;
+                }
+                if (state == pending) {
+                    _queue->_data_waiters.wait(_queue->_state_at(r_idx), std::uint8_t(pending));
+                }
+            }
+        }
+    };
+
+    /// Obtain the consumer end of the queue
+    [[nodiscard]] source_type source() noexcept { return source_type(*this); }
+};
+
+}  // namespace neo
@@ -0,0 +1,155 @@
+#include <neo/mpsc_byte_queue.hpp>
+
+#include <neo/buffer_algorithm.hpp>
+#include <neo/buffer_source.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::literals;
+
+NEO_TEST_CONCEPT(neo::buffer_source<neo::mpsc_byte_queue::source_type>);
+
+namespace {
+
+std::string read_all(neo::mpsc_byte_queue::source_type& source) {
+    std::string ret;
+    while (true) {
+        auto buf = source.next(1024);
+        if (buf.empty()) {
+            return ret;
+        }
+        ret.append(reinterpret_cast<const char*>(buf.data()), buf.size());
+        source.consume(buf.size());
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Write and read a queue") {
+    neo::mpsc_byte_queue queue{64};
+    CHECK(queue.capacity() == 64);
+    auto source = queue.source();
+
+    queue.write(neo::const_buffer("Hello, "));
+    queue.write(neo::const_buffer("world!"));
+    CHECK(source.next(100).equals_string("Hello, "sv));
+
+    std::string str;
+    str.resize(10);
+    CHECK(neo::buffer_copy(neo::as_buffer(str), source) == 10);
+    CHECK(str == "Hello, wor");
+    CHECK(read_all(source) == "ld!");
+}
+
+TEST_CASE("Commit reservations out of order") {
+    neo::mpsc_byte_queue queue{64};
+    auto                 source = queue.source();
+
+    auto first  = queue.reserve(3);
+    auto second = queue.reserve(3);
+    neo::buffer_copy(first.buffer(), neo::const_buffer("abc"));
+    neo::buffer_copy(second.buffer(), neo::const_buffer("def"));
+
+    // Nothing can be read until the first reservation is committed
+    queue.commit(second);
+    CHECK(source.next(100).empty());
+    queue.commit(first);
+    CHECK(read_all(source) == "abcdef");
+}
+
+TEST_CASE("Records are never split around the end of the ring") {
+    neo::mpsc_byte_queue queue{64};
+    auto                 source = queue.source();
+
+    for (auto i = 0; i < 20; ++i) {
+        auto r = queue.reserve(20);
+        CHECK(neo::buffer_size(r.buffer()) == 20);
+        std::memset(r.buffer().data(), 'a' + i, 20);
+        queue.commit(r);
+        CHECK(read_all(source) == std::string(20, char('a' + i)));
+    }
+}
+
+TEST_CASE("Released payload bytes are never read as a record") {
+    neo::mpsc_byte_queue queue{64};
+    auto                 source = queue.source();
+
+    // Fill most of the ring with bytes that would look like a committed header
+    auto r = queue.reserve(40);
+    std::memset(r.buffer().data(), 1, 40);
+    queue.commit(r);
+    CHECK(read_all(source) == std::string(40, '\x01'));
+    queue.write(neo::const_buffer("abcdefgh"));
+    CHECK(read_all(source) == "abcdefgh");
+    // The read position is now inside the space of the first record
+    queue.write(neo::const_buffer());
+    CHECK(source.next(100).empty());
+
+    queue.write(neo::const_buffer("xyz"));
+    CHECK(read_all(source) == "xyz");
+}
+
+TEST_CASE("Close a queue") {
+    neo::mpsc_byte_queue queue{64};
+    auto                 source = queue.source();
+    queue.write(neo::const_buffer("abc"));
+    queue.close();
+    CHECK(source.wait_readable());
+    CHECK(read_all(source) == "abc");
+    CHECK_FALSE(source.wait_readable());
+}
+
+TEST_CASE("Write from many threads") {
+    neo::mpsc_byte_queue queue{256};
+    constexpr int        n_threads = 4;
+    constexpr int        n_records = 5000;
+
+    std::vector<std::thread> producers;
+    for (auto t = 0; t < n_threads; ++t) {
+        producers.emplace_back([&queue, t] {
+            for (auto i = 0; i < n_records; ++i) {
+                // Each record is filled with a letter identifying its thread
+                auto r   = queue.reserve(std::size_t(1 + i % 17));
+                auto buf = r.buffer();
+                std::memset(buf.data(), 'a' + t, buf.size());
+                queue.commit(r);
+            }
+        });
+    }
+    std::thread closer{[&] {
+        for (auto& t : producers) {
+            t.join();
+        }
+        queue.close();
+    }};
+
+    auto        source = queue.source();
+    std::size_t counts[n_threads] = {};
+    bool        unmixed           = true;
+    while (source.wait_readable()) {
+        auto buf = source.next(1024);
+        auto t   = std::to_integer<int>(buf[0]) - 'a';
+        for (auto b : std::string_view(reinterpret_cast<const char*>(buf.data()), buf.size())) {
+            unmixed = unmixed && b == 'a' + t;
+        }
+        counts[t] += buf.size();
+        source.consume(buf.size());
+    }
+    closer.join();
+
+    CHECK(unmixed);
+    std::size_t expect = 0;
+    for (auto i = 0; i < n_records; ++i) {
+        expect += std::size_t(1 + i % 17);
+    }
+    for (auto count : counts) {
+        CHECK(count == expect);
+    }
+}
@@ -2,8 +2,12 @@
 
 #include <neo/buffer_range.hpp>
 
+#include <neo/assert.hpp>
 #include <neo/iterator_facade.hpp>
 
+#include <algorithm>
+#include <cstddef>
+
 namespace neo {
 
 /**
@@ -13,11 +17,16 @@ namespace neo {
  * behavior of buffer_range wherein the buffer emits *single bytes* at a time. The
  * range iterator type is only a forward_iterator.
  *
+ * A larger segment size may be given, in which case the range emits buffers of
+ * that many bytes (the final buffer may be shorter). This simulates data that
+ * arrives in fragments, such as from a network.
+ *
  * @tparam Buf The underlying buffer type.
  */
 template <single_buffer Buf>
 class pathological_buffer_range {
-    Buf _buf;
+    Buf         _buf;
+    std::size_t _segment_size = 1;
 
 public:
     using buffer_type = Buf;
@@ -27,19 +36,44 @@ public:
     constexpr pathological_buffer_range(buffer_type b)
         : _buf(b) {}
 
+    constexpr pathological_buffer_range(buffer_type b, std::size_t segment_size)
+        : _buf(b)
+        , _segment_size(segment_size) {
+        neo_assert(expects,
+                   segment_size != 0,
+                   "pathological_buffer_range segment size must be non-zero");
+    }
+
+    /// The size of each buffer emitted by the range, except possibly the last
+    [[nodiscard]] constexpr std::size_t segment_size() const noexcept { return _segment_size; }
+
     struct iterator : neo::iterator_facade<iterator> {
-        pointer _ptr = nullptr;
-        iterator()   = default;
-        iterator(pointer p)
-            : _ptr(p) {}
-
-        constexpr buffer_type dereference() const noexcept { return buffer_type(_ptr, 1); }
-        constexpr void        increment() noexcept { ++_ptr; }
-        constexpr bool        operator==(iterator o) const noexcept { return _ptr == o._ptr; }
+        pointer     _ptr      = nullptr;
+        pointer     _stop     = nullptr;
+        std::size_t _seg_size = 1;
+        iterator()            = default;
+        constexpr iterator(pointer p, pointer stop, std::size_t seg_size)
+            : _ptr(p)
+            , _stop(stop)
+            , _seg_size(seg_size) {}
+
+        constexpr std::size_t _cur_size() const noexcept {
+            return (std::min)(_seg_size, static_cast<std::size_t>(_stop - _ptr));
+        }
+
+        constexpr buffer_type dereference() const noexcept {
+            return buffer_type(_ptr, _cur_size());
+        }
+        constexpr void increment() noexcept { _ptr += _cur_size(); }
+        constexpr bool operator==(iterator o) const noexcept { return _ptr == o._ptr; }
     };
 
-    constexpr auto begin() const noexcept { return iterator(_buf.data()); }
-    constexpr auto end() const noexcept { return iterator(_buf.data_end()); }
+    constexpr auto begin() const noexcept {
+        return iterator(_buf.data(), _buf.data_end(), _segment_size);
+    }
+    constexpr auto end() const noexcept {
+        return iterator(_buf.data_end(), _buf.data_end(), _segment_size);
+    }
 };
 
 }  // namespace neo
@@ -1,5 +1,7 @@
 #include "./pathological_buffer_range.hpp"
 
+#include <neo/buffer_algorithm/size.hpp>
+
 #include <neo/test_concept.hpp>
 
 #include <catch2/catch.hpp>
@@ -16,3 +18,22 @@ TEST_CASE("Iterate over a pathological buffer case") {
     ++it;
     CHECK((*it)[0] == std::byte('e'));
 }
+
+TEST_CASE("Iterate over a fragmented buffer") {
+    neo::pathological_buffer_range rng(neo::const_buffer("Hello, world!"), 5);
+    CHECK(rng.segment_size() == 5);
+
+    auto it = rng.begin();
+    CHECK(it->size() == 5);
+    CHECK((*it)[0] == std::byte('H'));
+    ++it;
+    CHECK(it->size() == 5);
+    CHECK((*it)[0] == std::byte(','));
+    ++it;
+    // The final buffer holds only what remains
+    CHECK(it->size() == 3);
+    CHECK((*it)[0] == std::byte('l'));
+    ++it;
+    CHECK(it == rng.end());
+    CHECK(neo::buffer_size(rng) == 13);
+}
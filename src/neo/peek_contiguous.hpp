@@ -0,0 +1,119 @@
+#pragma once
+
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffer_source.hpp>
+#include <neo/byte_array.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <neo/fwd.hpp>
+#include <neo/ref_member.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace neo {
+
+// clang-format off
+template <typename T>
+concept has_member_peek_contiguous = requires(T t, std::size_t n, mutable_buffer scratch) {
+    { t.peek_contiguous(n, scratch) } -> convertible_to<const_buffer>;
+};
+// clang-format on
+
+/**
+ * Obtain the next `n` bytes from the given source as a single contiguous
+ * buffer, without consuming them.
+ *
+ * If the source provides its own `peek_contiguous()`, that will be used.
+ * Otherwise, `n` bytes are requested from the source: if the first buffer
+ * holds all of them, it is returned directly, and otherwise the bytes are
+ * copied into `scratch`. The returned buffer is smaller than `n` only if the
+ * source did not provide `n` bytes or `scratch` is too small to hold them.
+ */
+template <buffer_source Source>
+[[nodiscard]] constexpr const_buffer
+peek_contiguous(Source& src, std::size_t n, mutable_buffer scratch) noexcept(
+    noexcept(src.next(n))) {
+    if constexpr (has_member_peek_contiguous<Source&>) {
+        return src.peek_contiguous(n, scratch);
+    } else {
+        auto&& bufs = src.next(n);
+        if constexpr (single_buffer<std::remove_cvref_t<decltype(bufs)>>) {
+            return as_buffer(bufs, n);
+        } else {
+            auto it = std::begin(bufs);
+            if (it == std::end(bufs)) {
+                return const_buffer();
+            }
+            const_buffer first = as_buffer(*it, n);
+            if (first.size() == n || scratch.size() <= first.size()) {
+                return first;
+            }
+            auto n_copied = buffer_copy(scratch, bufs, n);
+            if (n_copied == first.size()) {
+                // There were no more bytes beyond the first buffer
+                return first;
+            }
+            return const_buffer(scratch.data(), n_copied);
+        }
+    }
+}
+
+/**
+ * Wrap a `buffer_source` and provide a `peek_contiguous()` that linearizes
+ * into an inline scratch array of `ScratchSize` bytes. The number of times
+ * that linearization was needed is available via `linearized_count()`.
+ *
+ * A buffer returned from `peek_contiguous()` may refer to the scratch array,
+ * and is invalidated by the next call to `peek_contiguous()` or by moving the
+ * wrapper.
+ */
+template <buffer_source Source, std::size_t ScratchSize = 64>
+class peeking_source {
+    [[no_unique_address]] wrap_ref_member_t<Source> _source;
+
+    byte_array<ScratchSize> _scratch{};
+    std::size_t             _n_linearized = 0;
+
+public:
+    constexpr peeking_source() = default;
+    constexpr explicit peeking_source(Source&& s) noexcept
+        : _source(NEO_FWD(s)) {}
+
+    NEO_DECL_UNREF_GETTER(source, _source);
+
+    /// The largest contiguous view that can be produced by linearization
+    constexpr static std::size_t scratch_size = ScratchSize;
+
+    [[nodiscard]] constexpr decltype(auto)
+    next(std::size_t n) noexcept(noexcept(source().next(n))) {
+        return source().next(n);
+    }
+
+    constexpr void consume(std::size_t n) noexcept { source().consume(n); }
+
+    /**
+     * Obtain the next `n` bytes as a single contiguous buffer, without
+     * consuming them. See `neo::peek_contiguous()`.
+     */
+    [[nodiscard]] constexpr const_buffer
+    peek_contiguous(std::size_t n) noexcept(noexcept(source().next(n))) {
+        auto buf = neo::peek_contiguous(source(), n, as_buffer(_scratch));
+        if (buf.data() == _scratch.data() && !buf.empty()) {
+            ++_n_linearized;
+        }
+        return buf;
+    }
+
+    /**
+     * The number of times that peek_contiguous() had to copy bytes into the
+     * scratch array.
+     */
+    [[nodiscard]] constexpr std::size_t linearized_count() const noexcept { return _n_linearized; }
+};
+
+template <typename S>
+explicit peeking_source(S&&) -> peeking_source<S>;
+
+}  // namespace neo
@@ -0,0 +1,84 @@
+#include <neo/peek_contiguous.hpp>
+
+#include <neo/buffers_consumer.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std::literals;
+
+NEO_TEST_CONCEPT(neo::buffer_source<neo::peeking_source<neo::proto_buffer_source>>);
+
+namespace {
+
+/// A source that only ever hands out a few bytes of each piece at a time
+struct chunked_source {
+    std::vector<std::string> chunks;
+    std::size_t              offset = 0;
+
+    std::vector<neo::const_buffer> bufs() const {
+        std::vector<neo::const_buffer> ret;
+        auto                           off = offset;
+        for (auto& c : chunks) {
+            if (off >= c.size()) {
+                off -= c.size();
+                continue;
+            }
+            ret.push_back(neo::as_buffer(c) + off);
+            off = 0;
+        }
+        return ret;
+    }
+
+    std::vector<neo::const_buffer> next(std::size_t) const { return bufs(); }
+    void                           consume(std::size_t n) noexcept { offset += n; }
+};
+
+}  // namespace
+
+TEST_CASE("Peek contiguous bytes from a generic source") {
+    chunked_source src{{"abc", "def", "ghi"}};
+    std::string    scratch_str;
+    scratch_str.resize(16);
+    auto scratch = neo::as_buffer(scratch_str);
+
+    auto part = neo::peek_contiguous(src, 2, scratch);
+    CHECK(part.equals_string("ab"sv));
+    CHECK(part.data() != scratch.data());
+
+    part = neo::peek_contiguous(src, 5, scratch);
+    CHECK(part.equals_string("abcde"sv));
+    CHECK(part.data() == scratch.data());
+
+    src.consume(8);
+    part = neo::peek_contiguous(src, 5, scratch);
+    CHECK(part.equals_string("i"sv));
+}
+
+TEST_CASE("Peek through a peeking_source") {
+    neo::peeking_source<chunked_source, 8> src{chunked_source{{"abc", "def", "ghi"}}};
+
+    CHECK(src.peek_contiguous(3).equals_string("abc"sv));
+    CHECK(src.linearized_count() == 0);
+    CHECK(src.peek_contiguous(5).equals_string("abcde"sv));
+    CHECK(src.linearized_count() == 1);
+    // Limited by the scratch size
+    CHECK(src.peek_contiguous(100).equals_string("abcdefgh"sv));
+    CHECK(src.linearized_count() == 2);
+
+    src.consume(4);
+    CHECK(src.peek_contiguous(2).equals_string("ef"sv));
+    CHECK(src.linearized_count() == 2);
+
+    // Peeking through a buffers_consumer uses the consumer's own peek
+    auto                  bufs = {neo::const_buffer("12"), neo::const_buffer("34")};
+    neo::buffers_consumer cons{bufs};
+    neo::peeking_source   peek{cons};
+    CHECK(peek.peek_contiguous(3).equals_string("123"sv));
+    CHECK(peek.linearized_count() == 1);
+    CHECK(cons.linearized_count() == 1);
+}
@@ -3,6 +3,7 @@
 #include <neo/as_buffer.hpp>
 #include <neo/as_dynamic_buffer.hpp>
 #include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffer_copy_accounting.hpp>
 
 #include <neo/assert.hpp>
 #include <neo/fwd.hpp>
@@ -23,6 +24,24 @@ private:
 
     std::size_t _beg_idx = 0;
     std::size_t _size    = unref(_storage).size();
+    /// The headroom that shifting the data will not eat into. See reserve_headroom().
+    std::size_t _min_headroom = 0;
+
+    [[no_unique_address]] detail::buffer_copy_accounting<shifting_dynamic_buffer> _copy_acct;
+
+    constexpr void _grow_inner(std::size_t n) noexcept(noexcept(inner_buffer().grow(n))) {
+        auto&&     inner  = inner_buffer();
+        const auto before = detail::buffer_copy_stats_of(inner);
+        inner.grow(n);
+        _copy_acct.absorb(before, detail::buffer_copy_stats_of(inner));
+    }
+
+    constexpr void _reset_if_empty() noexcept {
+        if (_size == 0) {
+            _beg_idx      = 0;
+            _min_headroom = 0;
+        }
+    }
 
 public:
     constexpr shifting_dynamic_buffer() = default;
@@ -70,13 +89,17 @@ public:
         if (avail_room >= more) {
             // There is enough room following the partial buffer to just expand into that
             _size += more;
+            _copy_acct.grown(more);
+            _copy_acct.observe(_size, inner_buffer().size());
             return data(prev_size, more);
-        } else if (_beg_idx != 0) {
+        } else if (_beg_idx > _min_headroom) {
             // We don't have enough room after the partial buffer to just expand it, but
             // we are offset from the beginning of the buffer and we might be able to make room
-            // by just shifting everyone over.
-            buffer_copy(inner_buffer().data(0, _size), inner_buffer().data(_beg_idx, _size));
-            _beg_idx = 0;
+            // by just shifting everyone over. Reserved headroom is kept.
+            buffer_copy(inner_buffer().data(_min_headroom, _size),
+                        inner_buffer().data(_beg_idx, _size));
+            _copy_acct.moved(_size);
+            _beg_idx = _min_headroom;
             // Try again now that we have more room.
             return grow(more);
         } else {
@@ -84,8 +107,10 @@ public:
             // backing storage.
             std::size_t min_grow    = more - avail_room;
             auto        growth_size = (std::max)(std::size_t(1024), min_grow);
-            inner_buffer().grow(growth_size);
+            _grow_inner(growth_size);
             _size += more;
+            _copy_acct.grown(more);
+            _copy_acct.observe(_size, inner_buffer().size());
             return data(prev_size, more);
         }
     }
@@ -97,9 +122,7 @@ public:
                    size_,
                    this->size());
         _size -= size_;
-        if (_size == 0) {
-            _beg_idx = 0;
-        }
+        _reset_if_empty();
     }
     constexpr void consume(std::size_t size_) noexcept {
         neo_assert(expects,
@@ -109,10 +132,78 @@ public:
                    this->size());
         _beg_idx += size_;
         _size -= size_;
-        if (_size == 0) {
-            _beg_idx = 0;
+        _reset_if_empty();
+    }
+
+    /**
+     * The number of bytes before the beginning of the data that are available
+     * to prepend().
+     */
+    constexpr std::size_t headroom() const noexcept { return _beg_idx; }
+
+    /**
+     * The number of bytes that the data can grow by without growing or
+     * shifting the storage.
+     */
+    constexpr std::size_t tailroom() const noexcept {
+        return inner_buffer().size() - _beg_idx - _size;
+    }
+
+    /**
+     * Reserve `n` bytes before the beginning of the data, so that a header of
+     * up to `n` bytes can later be added with prepend() after the data has been
+     * written. The buffer must be empty.
+     *
+     * Until the buffer is next emptied, growing the data will not shift it into
+     * the reserved space.
+     */
+    constexpr void reserve_headroom(std::size_t n) noexcept(noexcept(inner_buffer().grow(n))) {
+        neo_assert(expects,
+                   size() == 0,
+                   "Headroom can only be reserved in an empty dynamic buffer",
+                   n,
+                   size());
+        if (inner_buffer().size() < n) {
+            _grow_inner(n - inner_buffer().size());
+        }
+        _beg_idx      = n;
+        _min_headroom = n;
+    }
+
+    /**
+     * Ensure that the data can grow by at least `n` bytes without growing or
+     * shifting the storage, such as to later append a trailer.
+     */
+    constexpr void reserve_tailroom(std::size_t n) noexcept(noexcept(inner_buffer().grow(n))) {
+        if (tailroom() < n) {
+            _grow_inner(n - tailroom());
         }
     }
+
+    /**
+     * Extend the data at the front by `n` bytes taken from the headroom, and
+     * return the new bytes. The existing data is not moved.
+     */
+    constexpr auto prepend(std::size_t n) noexcept {
+        neo_assert(expects,
+                   n <= headroom(),
+                   "Cannot prepend more bytes than the headroom of a dynamic buffer",
+                   n,
+                   headroom());
+        _beg_idx -= n;
+        _size += n;
+        _copy_acct.grown(n);
+        _min_headroom = (std::min)(_min_headroom, _beg_idx);
+        return data(0, n);
+    }
+
+    /**
+     * The work done by this buffer, including the work done by its storage on
+     * its behalf. See NEO_BUFFER_COPY_ACCOUNTING.
+     */
+    [[nodiscard]] constexpr buffer_copy_stats copy_stats() const noexcept {
+        return _copy_acct.stats();
+    }
 };  // namespace neo
 
 template <as_dynamic_buffer_convertible S>
@@ -115,3 +115,54 @@ TEST_CASE("With bare dynamic_buffer_convertible") {
     dbuf.shrink(1);
     CHECK(dbuf.capacity() == 256);
 }
+
+TEST_CASE("Prepend a header into reserved headroom") {
+    std::string                  str;
+    neo::shifting_dynamic_buffer dbuf{str};
+    dbuf.reserve_headroom(4);
+    CHECK(dbuf.headroom() == 4);
+    CHECK(dbuf.size() == 0);
+
+    neo::buffer_copy(dbuf.grow(7), neo::const_buffer("payload"));
+    const auto payload_addr = dbuf.data(0, 1).data();
+    CHECK(dbuf.headroom() == 4);
+
+    neo::buffer_copy(dbuf.prepend(4), neo::const_buffer("HDR:"));
+    CHECK(dbuf.headroom() == 0);
+    CHECK(std::string_view(dbuf.data(0, dbuf.size())) == "HDR:payload");
+    // The payload was not moved
+    CHECK(dbuf.data(4, 1).data() == payload_addr);
+}
+
+TEST_CASE("Shifting keeps reserved headroom") {
+    std::string                  str;
+    neo::shifting_dynamic_buffer dbuf{str};
+    dbuf.reserve_headroom(8);
+    dbuf.grow(1000);
+    dbuf.consume(900);
+    CHECK(dbuf.headroom() == 908);
+    // Not enough room at the end, so the data is shifted down, but only as far as the reserved
+    // headroom
+    dbuf.grow(100);
+    CHECK(dbuf.headroom() == 8);
+    CHECK(dbuf.size() == 200);
+
+    // Emptying the buffer releases the reservation
+    dbuf.consume(200);
+    CHECK(dbuf.headroom() == 0);
+}
+
+TEST_CASE("Reserve tailroom for a trailer") {
+    std::string                  str;
+    neo::shifting_dynamic_buffer dbuf{str};
+    dbuf.grow(1024);
+    CHECK(dbuf.tailroom() == 0);
+    dbuf.reserve_tailroom(16);
+    CHECK(dbuf.tailroom() >= 16);
+    CHECK(dbuf.size() == 1024);
+
+    const auto data_addr = dbuf.data(0, 1).data();
+    dbuf.grow(16);
+    // Growing into the tailroom does not move the data
+    CHECK(dbuf.data(0, 1).data() == data_addr);
+}
@@ -0,0 +1,473 @@
+#pragma once
+
+#if defined(__linux__)
+
+#include <neo/const_buffer.hpp>
+#include <neo/detail/cache_line.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <neo/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <new>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace neo {
+
+namespace detail {
+
+/**
+ * The fixed description of a shared ring segment, which is validated when the
+ * segment is attached.
+ */
+struct shm_ring_info {
+    constexpr static std::uint64_t magic_value   = 0x676e6972'6f65'6e00;  // "\0neoring"
+    constexpr static std::uint32_t version_value = 1;
+
+    /// Written last, once the rest of the header is initialized
+    std::uint64_t magic       = 0;
+    std::uint32_t version     = version_value;
+    std::uint32_t data_offset = 0;
+    std::uint64_t capacity    = 0;
+};
+
+/**
+ * The control block at the start of a shared ring segment. Every field is
+ * either written once before the magic number is published, or is a lock-free
+ * atomic, so a process that dies at any point leaves the header consistent.
+ */
+struct shm_ring_header {
+    shm_ring_info info;
+
+    /// Written by the producer. The top bit is set once the producer closes the ring
+    alignas(cache_line_size) std::atomic<std::uint64_t> write_idx{0};
+    std::atomic<std::uint32_t> data_signal{0};
+    std::atomic<std::uint32_t> writer_waiting{0};
+
+    /// Written by the consumer
+    alignas(cache_line_size) std::atomic<std::uint64_t> read_idx{0};
+    std::atomic<std::uint32_t> space_signal{0};
+    std::atomic<std::uint32_t> reader_waiting{0};
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t));
+
+[[noreturn]] inline void throw_shm_error(const char* what) {
+    throw std::system_error(errno, std::system_category(), what);
+}
+
+/**
+ * Wait on a futex word that may be shared between processes. (std::atomic::wait
+ * cannot be used, since it may use process-private futexes.)
+ */
+inline void shm_futex_wait(std::atomic<std::uint32_t>& word,
+                           std::uint32_t               expect,
+                           std::chrono::nanoseconds    timeout) noexcept {
+    timespec  ts;
+    timespec* ts_ptr = nullptr;
+    if (timeout != std::chrono::nanoseconds::max()) {
+        const auto secs = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+        ts.tv_sec       = static_cast<std::time_t>(secs.count());
+        ts.tv_nsec      = static_cast<long>((timeout - secs).count());
+        ts_ptr          = &ts;
+    }
+    ::syscall(SYS_futex, &word, FUTEX_WAIT, expect, ts_ptr, nullptr, 0);
+}
+
+inline void shm_futex_wake(std::atomic<std::uint32_t>& word) noexcept {
+    ::syscall(SYS_futex, &word, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+}  // namespace detail
+
+/**
+ * A single-producer/single-consumer byte ring in memory that is shared between
+ * processes. One process writes through the `sink()` end, which is a
+ * `buffer_sink`, and another reads through the `source()` end, which is a
+ * `buffer_source`. Both ends return views directly into the shared memory, so
+ * bytes are copied once into the ring and never again.
+ *
+ * The ring is backed by a memfd. Create a ring with `create()`, pass its `fd()`
+ * to the peer process (by inheritance or over a Unix socket), and open it there
+ * with `attach()`. The data region is mapped twice, back-to-back, so the bytes
+ * returned by `prepare()` and `next()` are always contiguous even where they
+ * wrap around the end of the ring.
+ *
+ * Bytes are only visible to the reader once committed, so a writer that dies
+ * mid-write never exposes partial data. `attach()` validates the header before
+ * using it. The blocking waits accept a timeout, allowing a peer that has
+ * stopped responding to be detected.
+ *
+ * Only available on Linux.
+ */
+class shm_byte_ring {
+    constexpr static std::uint64_t _closed_bit = std::uint64_t(1) << 63;
+
+    int                      _fd       = -1;
+    std::byte*               _map      = nullptr;
+    std::size_t              _map_size = 0;
+    detail::shm_ring_header* _header   = nullptr;
+    std::byte*               _data     = nullptr;
+    std::size_t              _capacity = 0;
+
+    // Process-local copies of the peer's index, refreshed only when needed
+    std::uint64_t _cached_read_idx  = 0;
+    std::uint64_t _cached_write_idx = 0;
+
+    shm_byte_ring() = default;
+
+    static std::size_t _page_size() noexcept {
+        return static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    }
+
+    /// Map the header and two adjacent views of the data region
+    void _map_segment(std::size_t data_offset, std::size_t capacity) {
+        _map_size = data_offset + 2 * capacity;
+        auto base = ::mmap(nullptr, _map_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) {
+            detail::throw_shm_error("Failed to reserve address space for a shared ring");
+        }
+        _map = static_cast<std::byte*>(base);
+        auto first = ::mmap(_map,
+                            data_offset + capacity,
+                            PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_FIXED,
+                            _fd,
+                            0);
+        auto second = first == MAP_FAILED ? MAP_FAILED
+                                          : ::mmap(_map + data_offset + capacity,
+                                                   capacity,
+                                                   PROT_READ | PROT_WRITE,
+                                                   MAP_SHARED | MAP_FIXED,
+                                                   _fd,
+                                                   static_cast<off_t>(data_offset));
+        if (second == MAP_FAILED) {
+            detail::throw_shm_error("Failed to map a shared ring");
+        }
+        _header   = reinterpret_cast<detail::shm_ring_header*>(_map);
+        _data     = _map + data_offset;
+        _capacity = capacity;
+    }
+
+    void _reset() noexcept {
+        if (_map) {
+            ::munmap(_map, _map_size);
+        }
+        if (_fd != -1) {
+            ::close(_fd);
+        }
+        _fd  = -1;
+        _map = nullptr;
+    }
+
+public:
+    /**
+     * Create a new shared ring that can hold at least `min_capacity` bytes.
+     * The capacity is rounded up to a power of two that is a multiple of the
+     * page size. Throws `std::system_error` on failure.
+     */
+    [[nodiscard]] static shm_byte_ring create(std::size_t min_capacity) {
+        shm_byte_ring ret;
+        const auto    page        = _page_size();
+        const auto    capacity    = std::bit_ceil((std::max)(min_capacity, page));
+        const auto    data_offset = (std::max)(page, sizeof(detail::shm_ring_header));
+        ret._fd                   = ::memfd_create("neo-shm-byte-ring", MFD_CLOEXEC);
+        if (ret._fd == -1) {
+            detail::throw_shm_error("Failed to create a shared ring memfd");
+        }
+        if (::ftruncate(ret._fd, static_cast<off_t>(data_offset + capacity)) != 0) {
+            detail::throw_shm_error("Failed to size a shared ring memfd");
+        }
+        ret._map_segment(data_offset, capacity);
+        auto hdr              = new (ret._map) detail::shm_ring_header();
+        hdr->info.data_offset = static_cast<std::uint32_t>(data_offset);
+        hdr->info.capacity    = capacity;
+        // Publish the header last, so that a partially-initialized segment is never accepted
+        std::atomic_ref<std::uint64_t>(hdr->info.magic)
+            .store(detail::shm_ring_info::magic_value, std::memory_order_release);
+        return ret;
+    }
+
+    /**
+     * Open a shared ring from a file descriptor that refers to one created with
+     * `create()`. The descriptor is duplicated, and the caller keeps ownership
+     * of `fd`. Throws `std::system_error` if the descriptor does not refer to
+     * a valid ring.
+     */
+    [[nodiscard]] static shm_byte_ring attach(int fd) {
+        shm_byte_ring ret;
+        ret._fd = ::fcntl(fd, F_DUPFD_CLOEXEC, 0);
+        if (ret._fd == -1) {
+            detail::throw_shm_error("Failed to duplicate a shared ring file descriptor");
+        }
+        struct ::stat st;
+        if (::fstat(ret._fd, &st) != 0) {
+            detail::throw_shm_error("Failed to inspect a shared ring file descriptor");
+        }
+        detail::shm_ring_info info;
+        if (static_cast<std::size_t>(st.st_size) < sizeof(detail::shm_ring_header)
+            || ::pread(ret._fd, &info, sizeof(info), 0) != sizeof(info)) {
+            errno = EINVAL;
+            detail::throw_shm_error("File descriptor does not refer to a shared ring");
+        }
+        const auto data_offset = std::size_t(info.data_offset);
+        const auto capacity    = std::size_t(info.capacity);
+        const auto page        = _page_size();
+        if (info.magic != detail::shm_ring_info::magic_value
+            || info.version != detail::shm_ring_info::version_value
+            || data_offset % page != 0 || data_offset < sizeof(detail::shm_ring_header)
+            || !std::has_single_bit(capacity) || capacity % page != 0
+            || static_cast<std::size_t>(st.st_size) != data_offset + capacity) {
+            errno = EINVAL;
+            detail::throw_shm_error("Shared ring header is invalid");
+        }
+        ret._map_segment(data_offset, capacity);
+        const auto w_idx = ret._header->write_idx.load(std::memory_order_acquire) & ~_closed_bit;
+        const auto r_idx = ret._header->read_idx.load(std::memory_order_acquire);
+        if (w_idx - r_idx > capacity) {
+            errno = EINVAL;
+            detail::throw_shm_error("Shared ring indices are inconsistent");
+        }
+        ret._cached_read_idx  = r_idx;
+        ret._cached_write_idx = w_idx;
+        return ret;
+    }
+
+    shm_byte_ring(shm_byte_ring&& o) noexcept { *this = std::move(o); }
+
+    shm_byte_ring& operator=(shm_byte_ring&& o) noexcept {
+        _reset();
+        _fd               = std::exchange(o._fd, -1);
+        _map              = std::exchange(o._map, nullptr);
+        _map_size         = o._map_size;
+        _header           = o._header;
+        _data             = o._data;
+        _capacity         = o._capacity;
+        _cached_read_idx  = o._cached_read_idx;
+        _cached_write_idx = o._cached_write_idx;
+        return *this;
+    }
+
+    ~shm_byte_ring() { _reset(); }
+
+    /// The file descriptor of the shared memory, to be passed to `attach()`
+    [[nodiscard]] int fd() const noexcept { return _fd; }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return _capacity; }
+
+    /**
+     * The producer end of a shared ring. Only one thread in one process may
+     * write to a ring. Refers to the ring object, which must not be moved while
+     * the sink is in use.
+     */
+    class sink_type {
+        shm_byte_ring* _ring;
+
+        std::uint64_t _write_idx() const noexcept {
+            return _ring->_header->write_idx.load(std::memory_order_relaxed) & ~_closed_bit;
+        }
+
+        std::size_t _writable(std::size_t want) const noexcept {
+            const auto w_idx = _write_idx();
+            auto       avail = _ring->_capacity - (w_idx - _ring->_cached_read_idx);
+            if (avail < want) {
+                _ring->_cached_read_idx = _ring->_header->read_idx.load(std::memory_order_acquire);
+                avail = _ring->_capacity - (w_idx - _ring->_cached_read_idx);
+            }
+            return avail;
+        }
+
+    public:
+        explicit sink_type(shm_byte_ring& r) noexcept
+            : _ring(&r) {}
+
+        /**
+         * Obtain up to `n` bytes of contiguous free space in the shared
+         * memory. Fewer bytes are returned if the ring does not have room.
+         */
+        [[nodiscard]] mutable_buffer prepare(std::size_t n) noexcept {
+            n = (std::min)(n, _writable(n));
+            return mutable_buffer(_ring->_data + (_write_idx() & (_ring->_capacity - 1)), n);
+        }
+
+        /**
+         * Publish `n` prepared bytes to the reader.
+         */
+        void commit(std::size_t n) noexcept {
+            neo_assert(expects,
+                       n <= _ring->_capacity - (_write_idx() - _ring->_cached_read_idx),
+                       "Committed more bytes than were prepared in an shm_byte_ring",
+                       n);
+            auto& hdr = *_ring->_header;
+            hdr.write_idx.store(hdr.write_idx.load(std::memory_order_relaxed) + n);
+            if (hdr.reader_waiting.load()) {
+                hdr.data_signal.fetch_add(1);
+                detail::shm_futex_wake(hdr.data_signal);
+            }
+        }
+
+        /**
+         * Block until at least `n` bytes (clamped to the capacity) may be
+         * prepared, or until `timeout` elapses. Returns the number of bytes that
+         * may be prepared.
+         */
+        std::size_t
+        wait_writable(std::size_t              n       = 1,
+                      std::chrono::nanoseconds timeout = std::chrono::nanoseconds::max()) noexcept {
+            n                   = (std::min)(n, _ring->_capacity);
+            auto&      hdr      = *_ring->_header;
+            const bool forever  = timeout == std::chrono::nanoseconds::max();
+            const auto deadline = forever ? std::chrono::steady_clock::time_point::max()
+                                          : std::chrono::steady_clock::now() + timeout;
+            while (true) {
+                const auto avail = _writable(n);
+                if (avail >= n) {
+                    return avail;
+                }
+                const auto remain = deadline - std::chrono::steady_clock::now();
+                if (!forever && remain <= remain.zero()) {
+                    return avail;
+                }
+                const auto sig = hdr.space_signal.load();
+                hdr.writer_waiting.store(1);
+                // Order the flag store before re-loading the peer's index. Paired with the
+                // seq_cst store and flag load in the peer, this prevents a lost wakeup.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (_writable(n) < n) {
+                    detail::shm_futex_wait(hdr.space_signal, sig, forever ? timeout : remain);
+                }
+                hdr.writer_waiting.store(0);
+            }
+        }
+
+        /**
+         * Mark the end of the byte stream. Committed bytes can still be read.
+         */
+        void close() noexcept {
+            auto& hdr = *_ring->_header;
+            hdr.write_idx.fetch_or(_closed_bit);
+            hdr.data_signal.fetch_add(1);
+            detail::shm_futex_wake(hdr.data_signal);
+        }
+    };
+
+    /**
+     * The consumer end of a shared ring. Only one thread in one process may
+     * read from a ring. Refers to the ring object, which must not be moved
+     * while the source is in use.
+     */
+    class source_type {
+        shm_byte_ring* _ring;
+
+        std::uint64_t _read_idx() const noexcept {
+            return _ring->_header->read_idx.load(std::memory_order_relaxed);
+        }
+
+        std::size_t _readable(std::size_t want) const noexcept {
+            const auto r_idx = _read_idx();
+            auto       avail = _ring->_cached_write_idx - r_idx;
+            if (avail < want) {
+                _ring->_cached_write_idx
+                    = _ring->_header->write_idx.load(std::memory_order_acquire) & ~_closed_bit;
+                avail = _ring->_cached_write_idx - r_idx;
+            }
+            return avail;
+        }
+
+    public:
+        explicit source_type(shm_byte_ring& r) noexcept
+            : _ring(&r) {}
+
+        /**
+         * Obtain a view of up to `n` committed bytes in the shared memory. The
+         * view is contiguous even if it wraps around the end of the ring.
+         */
+        [[nodiscard]] const_buffer next(std::size_t n) noexcept {
+            n = (std::min)(n, _readable(n));
+            return const_buffer(_ring->_data + (_read_idx() & (_ring->_capacity - 1)), n);
+        }
+
+        /**
+         * Release `n` bytes back to the writer.
+         */
+        void consume(std::size_t n) noexcept {
+            neo_assert(expects,
+                       n <= _ring->_cached_write_idx - _read_idx(),
+                       "Consumed more bytes than are available in an shm_byte_ring",
+                       n);
+            auto& hdr = *_ring->_header;
+            hdr.read_idx.store(hdr.read_idx.load(std::memory_order_relaxed) + n);
+            if (hdr.writer_waiting.load()) {
+                hdr.space_signal.fetch_add(1);
+                detail::shm_futex_wake(hdr.space_signal);
+            }
+        }
+
+        /**
+         * Block until at least `n` bytes (clamped to the capacity) are
+         * available, the writer closes the ring, or `timeout` elapses. Returns
+         * the number of bytes available.
+         */
+        std::size_t
+        wait_readable(std::size_t              n       = 1,
+                      std::chrono::nanoseconds timeout = std::chrono::nanoseconds::max()) noexcept {
+            n                   = (std::min)(n, _ring->_capacity);
+            auto&      hdr      = *_ring->_header;
+            const bool forever  = timeout == std::chrono::nanoseconds::max();
+            const auto deadline = forever ? std::chrono::steady_clock::time_point::max()
+                                          : std::chrono::steady_clock::now() + timeout;
+            while (true) {
+                const auto avail = _readable(n);
+                if (avail >= n || closed()) {
+                    return _readable(n);
+                }
+                const auto remain = deadline - std::chrono::steady_clock::now();
+                if (!forever && remain <= remain.zero()) {
+                    return avail;
+                }
+                const auto sig = hdr.data_signal.load();
+                hdr.reader_waiting.store(1);
+                // See wait_writable()
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (_readable(n) < n && !closed()) {
+                    detail::shm_futex_wait(hdr.data_signal, sig, forever ? timeout : remain);
+                }
+                hdr.reader_waiting.store(0);
+            }
+        }
+
+        /**
+         * Determine whether the writer has closed the ring. Bytes may still be
+         * available to read.
+         */
+        [[nodiscard]] bool closed() const noexcept {
+            return _ring->_header->write_idx.load(std::memory_order_acquire) & _closed_bit;
+        }
+    };
+
+    /// Obtain the producer end of the ring
+    [[nodiscard]] sink_type sink() noexcept { return sink_type(*this); }
+    /// Obtain the consumer end of the ring
+    [[nodiscard]] source_type source() noexcept { return source_type(*this); }
+};
+
+}  // namespace neo
+
+#endif  // __linux__
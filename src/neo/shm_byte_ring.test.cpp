@@ -0,0 +1,110 @@
+#include <neo/shm_byte_ring.hpp>
+
+#if defined(__linux__)
+
+#include <neo/buffer_algorithm.hpp>
+#include <neo/buffer_sink.hpp>
+#include <neo/buffer_source.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+#include <sys/wait.h>
+
+using namespace std::literals;
+
+NEO_TEST_CONCEPT(neo::buffer_sink<neo::shm_byte_ring::sink_type>);
+NEO_TEST_CONCEPT(neo::buffer_source<neo::shm_byte_ring::source_type>);
+
+TEST_CASE("Write and read a shared ring in one process") {
+    auto ring = neo::shm_byte_ring::create(1);
+    CHECK(ring.capacity() >= 4096);
+
+    auto reader = neo::shm_byte_ring::attach(ring.fd());
+    auto sink   = ring.sink();
+    auto source = reader.source();
+
+    CHECK(source.next(100).empty());
+    neo::buffer_copy(sink, neo::const_buffer("Hello, shared memory!"));
+    CHECK(source.next(100).equals_string("Hello, shared memory!"sv));
+    source.consume(7);
+
+    source.consume(source.next(100).size());
+
+    // Fill up to just before the end of the ring, so that the next write wraps around
+    const auto cap   = ring.capacity();
+    auto       space = sink.prepare(cap - 4 - 21);
+    sink.commit(space.size());
+    source.consume(source.next(cap).size());
+
+    // The ring is mapped twice, so a wrapping write and read are contiguous
+    auto wrapped = sink.prepare(12);
+    CHECK(wrapped.size() == 12);
+    neo::buffer_copy(wrapped, neo::const_buffer("wrap-around!"));
+    sink.commit(12);
+    auto view = source.next(100);
+    CHECK(view.equals_string("wrap-around!"sv));
+    source.consume(view.size());
+
+    // Waiting times out when nothing is written
+    CHECK(source.wait_readable(1, 10ms) == 0);
+    sink.close();
+    CHECK(source.wait_readable() == 0);
+    CHECK(source.closed());
+}
+
+TEST_CASE("Reject a file that is not a shared ring") {
+    auto fd = ::memfd_create("not-a-ring", MFD_CLOEXEC);
+    REQUIRE(fd != -1);
+    REQUIRE(::ftruncate(fd, 3 * 4096) == 0);
+    CHECK_THROWS_AS(neo::shm_byte_ring::attach(fd), std::system_error);
+    ::close(fd);
+}
+
+TEST_CASE("Stream bytes between processes") {
+    auto ring = neo::shm_byte_ring::create(4096);
+
+    constexpr std::size_t n_bytes = 1024 * 1024;
+
+    auto pid = ::fork();
+    REQUIRE(pid != -1);
+    if (pid == 0) {
+        // The child process attaches to the inherited descriptor and writes
+        auto writer = neo::shm_byte_ring::attach(ring.fd());
+        auto sink   = writer.sink();
+        std::size_t n_written = 0;
+        while (n_written != n_bytes) {
+            sink.wait_writable();
+            auto buf = sink.prepare(n_bytes - n_written);
+            for (std::size_t idx = 0; idx != buf.size(); ++idx) {
+                buf[idx] = std::byte((n_written + idx) % 253);
+            }
+            sink.commit(buf.size());
+            n_written += buf.size();
+        }
+        sink.close();
+        ::_exit(0);
+    }
+
+    auto        source  = ring.source();
+    std::size_t n_read  = 0;
+    bool        matches = true;
+    while (source.wait_readable() != 0) {
+        auto buf = source.next(1000);
+        for (std::size_t idx = 0; idx != buf.size(); ++idx) {
+            matches = matches && buf[idx] == std::byte((n_read + idx) % 253);
+        }
+        n_read += buf.size();
+        source.consume(buf.size());
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    CHECK(WIFEXITED(status));
+    CHECK(matches);
+    CHECK(n_read == n_bytes);
+}
+
+#endif
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <neo/buffer_algorithm/size.hpp>
+#include <neo/buffer_range.hpp>
+
+#include <neo/assert.hpp>
+#include <neo/fwd.hpp>
+#include <neo/ref_member.hpp>
+
+#include <iterator>
+
+namespace neo {
+
+/**
+ * Wrap a buffer range and compute its total size once, up-front. The result
+ * models `sized_buffer_range`, so `buffer_size()`, `buffer_size_at_least()`,
+ * and `buffer_is_empty()` on the wrapper do not walk the inner buffers.
+ *
+ * If `Range` is a reference, the referred-to range must not change size while
+ * the wrapper is in use.
+ */
+template <buffer_range Range>
+class sized_buffers {
+public:
+    using range_type = std::remove_cvref_t<Range>;
+
+private:
+    [[no_unique_address]] wrap_ref_member_t<Range> _range;
+
+    std::size_t _size = buffer_size(unref(_range));
+
+public:
+    constexpr sized_buffers() = default;
+
+    constexpr explicit sized_buffers(Range&& r) noexcept
+        : _range(NEO_FWD(r)) {}
+
+    /**
+     * Wrap a range whose size is already known by the caller.
+     */
+    constexpr sized_buffers(Range&& r, std::size_t size) noexcept
+        : _range(NEO_FWD(r))
+        , _size(size) {
+        neo_assert(expects,
+                   size == buffer_size(range()),
+                   "The given size does not match the size of the buffer range",
+                   size,
+                   buffer_size(range()));
+    }
+
+    NEO_DECL_UNREF_GETTER(range, _range);
+
+    constexpr std::size_t byte_size() const noexcept { return _size; }
+
+    constexpr auto begin() const noexcept { return std::begin(range()); }
+    constexpr auto end() const noexcept { return std::end(range()); }
+};
+
+template <typename Range>
+sized_buffers(Range&&) -> sized_buffers<Range>;
+
+template <typename Range>
+sized_buffers(Range&&, std::size_t) -> sized_buffers<Range>;
+
+}  // namespace neo
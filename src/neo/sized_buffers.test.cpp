@@ -0,0 +1,57 @@
+#include <neo/sized_buffers.hpp>
+
+#include <neo/buffer_algorithm.hpp>
+#include <neo/buffers_cat.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/flat_buffer_sequence.hpp>
+#include <neo/static_buffer_vector.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+NEO_TEST_CONCEPT(neo::sized_buffer_range<neo::sized_buffers<std::vector<neo::const_buffer>>>);
+NEO_TEST_CONCEPT(neo::sized_buffer_range<neo::sized_buffers<std::vector<neo::const_buffer>&>>);
+NEO_TEST_CONCEPT(neo::sized_buffer_range<neo::flat_buffer_sequence<neo::const_buffer>>);
+NEO_TEST_CONCEPT(!neo::sized_buffer_range<std::vector<neo::const_buffer>>);
+NEO_TEST_CONCEPT(
+    neo::sized_buffer_range<neo::sized_buffers<neo::static_buffer_vector<neo::const_buffer, 4>>>);
+NEO_TEST_CONCEPT(!neo::sized_buffer_range<neo::proto_buffer_range>);
+
+// A concatenation is sized only if all of its parts are sized
+using small_vec = neo::flat_buffer_sequence<neo::const_buffer, 4>;
+NEO_TEST_CONCEPT(neo::sized_buffer_range<neo::buffers_seq_concat<small_vec, small_vec>>);
+NEO_TEST_CONCEPT(
+    !neo::sized_buffer_range<neo::buffers_seq_concat<small_vec, std::vector<neo::const_buffer>>>);
+
+TEST_CASE("Cache the size of a buffer range") {
+    std::vector<neo::const_buffer> bufs = {
+        neo::const_buffer("first"),
+        neo::const_buffer(""),
+        neo::const_buffer("second"),
+    };
+    neo::sized_buffers sized{bufs};
+    CHECK(sized.byte_size() == 11);
+    CHECK(neo::buffer_size(sized) == 11);
+    CHECK(neo::buffer_size_at_least(sized, 11));
+    CHECK_FALSE(neo::buffer_size_at_least(sized, 12));
+    CHECK_FALSE(neo::buffer_is_empty(sized));
+    CHECK(neo::buffer_count(sized) == 3);
+
+    std::vector<neo::const_buffer> empty;
+    CHECK(neo::buffer_is_empty(neo::sized_buffers{empty}));
+}
+
+TEST_CASE("Track the size of a flat_buffer_sequence and its concatenation") {
+    neo::flat_buffer_sequence<neo::const_buffer, 4> a;
+    neo::flat_buffer_sequence<neo::const_buffer, 4> b;
+    a.push_back(neo::const_buffer("foo"));
+    b.push_back(neo::const_buffer("barbaz"));
+    CHECK(a.byte_size() == 3);
+    auto cat = neo::buffers_cat(a, b);
+    CHECK(cat.byte_size() == 9);
+    b.push_back(neo::const_buffer("!"));
+    CHECK(neo::buffer_size(cat) == 10);
+}
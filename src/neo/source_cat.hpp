@@ -0,0 +1,139 @@
+#pragma once
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffer_algorithm/size.hpp>
+#include <neo/buffer_range.hpp>
+#include <neo/buffer_source.hpp>
+
+#include <neo/assert.hpp>
+#include <neo/fwd.hpp>
+#include <neo/ref_member.hpp>
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace neo {
+
+namespace detail {
+
+template <typename Source>
+using source_next_t = std::remove_cvref_t<decltype(
+    unref(std::declval<wrap_ref_member_t<Source>&>()).next(std::size_t()))>;
+
+template <typename First, typename... Rest>
+constexpr bool all_same_v = (std::is_same_v<First, Rest> && ...);
+
+}  // namespace detail
+
+/**
+ * A buffer_source that reads each of `Sources` in turn until it is exhausted.
+ * The buffers of each source are given directly to the reader, so nothing is
+ * copied or buffered.
+ *
+ * A source is considered exhausted when it yields no bytes from `next()`.
+ */
+template <buffer_source... Sources>
+class source_cat {
+    static_assert(sizeof...(Sources) != 0, "source_cat requires at least one source");
+
+    constexpr static std::size_t _n_sources = sizeof...(Sources);
+
+    constexpr static bool _same_next_type
+        = detail::all_same_v<detail::source_next_t<Sources>...>;
+
+public:
+    /**
+     * The type returned by `next()`. If every source returns the same type,
+     * then it is that type. Otherwise, it is a single buffer which is mutable
+     * only if every source yields mutable buffers, and `next()` returns the
+     * first buffer of the current source's buffers.
+     */
+    using buffer_type = std::conditional_t<
+        _same_next_type,
+        std::tuple_element_t<0, std::tuple<detail::source_next_t<Sources>...>>,
+        std::conditional_t<(mutable_buffer_range<detail::source_next_t<Sources>> && ...),
+                           mutable_buffer,
+                           const_buffer>>;
+
+private:
+    [[no_unique_address]] std::tuple<wrap_ref_member_t<Sources>...> _sources;
+
+    /// The index of the source being read
+    std::size_t _index = 0;
+
+    template <typename Bufs>
+    constexpr static buffer_type _as_result(Bufs&& bufs) noexcept {
+        if constexpr (_same_next_type) {
+            return NEO_FWD(bufs);
+        } else {
+            for (auto&& part : bufs) {
+                auto buf = buffer_type(as_buffer(part));
+                if (buf.size() != 0) {
+                    return buf;
+                }
+            }
+            return buffer_type();
+        }
+    }
+
+    template <std::size_t I>
+    constexpr buffer_type _next(std::size_t n) {
+        if constexpr (I == _n_sources) {
+            return buffer_type();
+        } else {
+            if (_index == I) {
+                auto bufs = source<I>().next(n);
+                if (buffer_size(bufs) != 0 || n == 0) {
+                    return _as_result(std::move(bufs));
+                }
+                // This source is exhausted. Move to the next one.
+                ++_index;
+            }
+            return _next<I + 1>(n);
+        }
+    }
+
+    template <std::size_t... Is>
+    constexpr void _consume(std::size_t n, std::index_sequence<Is...>) noexcept {
+        ((_index == Is ? source<Is>().consume(n) : void()), ...);
+    }
+
+public:
+    constexpr source_cat() = default;
+
+    constexpr explicit source_cat(Sources&&... srcs) noexcept
+        : _sources(NEO_FWD(srcs)...) {}
+
+    template <std::size_t I>
+    constexpr decltype(auto) source() noexcept {
+        return unref(std::get<I>(_sources));
+    }
+
+    template <std::size_t I>
+    constexpr decltype(auto) source() const noexcept {
+        return unref(std::get<I>(_sources));
+    }
+
+    /**
+     * The index of the source currently being read. Equal to the number of
+     * sources once all of them are exhausted.
+     */
+    [[nodiscard]] constexpr std::size_t current_index() const noexcept { return _index; }
+
+    constexpr buffer_type next(std::size_t n) { return _next<0>(n); }
+
+    constexpr void consume(std::size_t n) noexcept {
+        neo_assert(expects,
+                   _index < _n_sources || n == 0,
+                   "Attempted to consume from a source_cat with all sources exhausted",
+                   n);
+        _consume(n, std::index_sequence_for<Sources...>{});
+    }
+};
+
+template <typename... Sources>
+explicit source_cat(Sources&&...) -> source_cat<Sources...>;
+
+}  // namespace neo
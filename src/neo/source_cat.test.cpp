@@ -0,0 +1,73 @@
+#include <neo/source_cat.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffers_consumer.hpp>
+#include <neo/string_io.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <utility>
+
+NEO_TEST_CONCEPT(neo::buffer_source<neo::source_cat<neo::proto_buffer_source&>>);
+NEO_TEST_CONCEPT(
+    neo::buffer_source<neo::source_cat<neo::buffers_consumer<neo::const_buffer>&,
+                                       neo::string_dynbuf_io&>>);
+
+TEST_CASE("Read a buffered prefix followed by the rest of the stream") {
+    std::string           prefix_str = "GET / HTTP/1.1\r\n";
+    neo::buffers_consumer prefix{neo::as_buffer(std::as_const(prefix_str))};
+
+    neo::string_dynbuf_io rest;
+    neo::buffer_copy(rest, neo::as_buffer(std::string("Host: example.com\r\n\r\n")));
+
+    neo::source_cat cat{prefix, rest};
+    CHECK(cat.current_index() == 0);
+
+    // The first buffer is the prefix itself, not a copy of it
+    auto first = cat.next(1024);
+    CHECK(neo::buffer_size(first) == prefix_str.size());
+    CHECK(neo::as_buffer(first).data() == neo::as_buffer(prefix_str).data());
+
+    neo::string_dynbuf_io out;
+    neo::buffer_copy(out, cat);
+    CHECK(out.read_area_view() == "GET / HTTP/1.1\r\nHost: example.com\r\n\r\n");
+    CHECK(cat.current_index() == 2);
+    CHECK(neo::buffer_size(cat.next(1024)) == 0);
+}
+
+TEST_CASE("Skip empty sources") {
+    neo::buffers_consumer a{neo::const_buffer()};
+    neo::buffers_consumer b{neo::as_buffer("Hello", 5)};
+    neo::buffers_consumer c{neo::const_buffer()};
+    neo::buffers_consumer d{neo::as_buffer(", world", 7)};
+
+    neo::source_cat cat{a, b, c, d};
+
+    std::string out;
+    out.resize(12);
+    auto n = neo::buffer_copy(neo::as_buffer(out), cat);
+    CHECK(n == 12);
+    CHECK(out == "Hello, world");
+}
+
+TEST_CASE("Read in small steps across the boundary") {
+    neo::buffers_consumer a{neo::as_buffer("abc", 3)};
+    neo::buffers_consumer b{neo::as_buffer("def", 3)};
+
+    neo::source_cat cat{a, b};
+
+    std::string out;
+    while (true) {
+        auto part = neo::as_buffer(cat.next(2));
+        if (part.size() == 0) {
+            break;
+        }
+        out.append(reinterpret_cast<const char*>(part.data()), part.size());
+        cat.consume(part.size());
+    }
+    CHECK(out == "abcdef");
+}
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <neo/const_buffer.hpp>
+#include <neo/detail/atomic_wait.hpp>
+#include <neo/detail/cache_line.hpp>
+#include <neo/mutable_buffer.hpp>
+#include <neo/static_buffer_vector.hpp>
+
+#include <neo/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+
+namespace neo {
+
+/**
+ * A wait-free single-producer/single-consumer ring of bytes. One thread writes
+ * into the pipe through its `sink()` end, which is a `buffer_sink`, and one
+ * other thread reads from it through its `source()` end, which is a
+ * `buffer_source`. The ends can be given to `buffer_copy()` and
+ * `buffer_transform()` like any other sink or source.
+ *
+ * The read and write indices live on separate cache lines, and each side keeps
+ * a cached copy of the other side's index that is only refreshed when it
+ * appears to be out of space. Each `commit()` or `consume()` publishes its
+ * bytes with a single atomic store, so bytes are handed over in batches.
+ *
+ * The ends are non-blocking. `wait_writable()` and `wait_readable()` may be used
+ * to block until there is room or data, using `std::atomic::wait()` (a futex on
+ * Linux) where it is available, or spinning and yielding where it is not. After
+ * their store, `commit()` and `consume()` check whether the other side is
+ * blocked in one of those calls, and only notify it if it is.
+ */
+class spsc_byte_pipe {
+    /// Set in the write index once the producer has closed the pipe
+    constexpr static std::size_t _closed_bit = std::size_t(1) << (sizeof(std::size_t) * 8 - 1);
+
+    std::unique_ptr<std::byte[]> _storage;
+    std::size_t                  _capacity;
+
+    struct alignas(detail::cache_line_size) producer_state {
+        std::atomic<std::size_t> write_idx{0};
+        std::size_t              cached_read_idx = 0;
+        /// Consumers blocked waiting for `write_idx` to change
+        detail::atomic_waiters data_waiters;
+    };
+
+    struct alignas(detail::cache_line_size) consumer_state {
+        std::atomic<std::size_t> read_idx{0};
+        std::size_t              cached_write_idx = 0;
+        /// Producers blocked waiting for `read_idx` to change
+        detail::atomic_waiters space_waiters;
+    };
+
+    producer_state _producer;
+    consumer_state _consumer;
+
+    template <typename Buffer, typename Ptr>
+    static_buffer_vector<Buffer, 2>
+    _split(Ptr data, std::size_t idx, std::size_t n) const noexcept {
+        static_buffer_vector<Buffer, 2> ret;
+        const auto                      offset = idx & (_capacity - 1);
+        const auto                      first  = (std::min)(n, _capacity - offset);
+        if (first) {
+            ret.push_back(Buffer(data + offset, first));
+        }
+        if (n - first) {
+            ret.push_back(Buffer(data, n - first));
+        }
+        return ret;
+    }
+
+public:
+    /**
+     * Create a pipe that can hold at least `min_capacity` bytes. The capacity
+     * is rounded up to a power of two.
+     */
+    explicit spsc_byte_pipe(std::size_t min_capacity)
+        : _capacity(std::bit_ceil((std::max)(min_capacity, std::size_t(1)))) {
+        _storage.reset(new std::byte[_capacity]);
+    }
+
+    spsc_byte_pipe(const spsc_byte_pipe&) = delete;
+    spsc_byte_pipe& operator=(const spsc_byte_pipe&) = delete;
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return _capacity; }
+
+    /**
+     * The producer end of a pipe. Must only be used from one thread at a time.
+     */
+    class sink_type {
+        spsc_byte_pipe* _pipe;
+
+        std::size_t _write_idx() const noexcept {
+            return _pipe->_producer.write_idx.load(std::memory_order_relaxed) & ~_closed_bit;
+        }
+
+        std::size_t _writable(std::size_t want) const noexcept {
+            auto&      prod  = _pipe->_producer;
+            const auto w_idx = _write_idx();
+            auto       avail = _pipe->_capacity - (w_idx - prod.cached_read_idx);
+            if (avail < want) {
+                prod.cached_read_idx = _pipe->_consumer.read_idx.load(std::memory_order_acquire);
+                avail                = _pipe->_capacity - (w_idx - prod.cached_read_idx);
+            }
+            return avail;
+        }
+
+    public:
+        explicit sink_type(spsc_byte_pipe& p) noexcept
+            : _pipe(&p) {}
+
+        /**
+         * Obtain up to `n` bytes of free space. The space may be split in two
+         * buffers where the ring wraps around. Fewer than `n` bytes are returned
+         * if the pipe does not have room for them.
+         */
+        [[nodiscard]] static_buffer_vector<mutable_buffer, 2> prepare(std::size_t n) noexcept {
+            n = (std::min)(n, _writable(n));
+            return _pipe->_split<mutable_buffer>(_pipe->_storage.get(), _write_idx(), n);
+        }
+
+        /**
+         * Publish `n` bytes from the prepared space to the consumer.
+         */
+        void commit(std::size_t n) noexcept {
+            neo_assert(expects,
+                       n <= _pipe->_capacity - (_write_idx() - _pipe->_producer.cached_read_idx),
+                       "Committed more bytes than were prepared in an spsc_byte_pipe",
+                       n);
+            auto& w_idx = _pipe->_producer.write_idx;
+            w_idx.store(w_idx.load(std::memory_order_relaxed) + n, std::memory_order_release);
+            _pipe->_producer.data_waiters.notify_one(w_idx);
+        }
+
+        /**
+         * Block until at least `n` bytes (clamped to the pipe's capacity) may be
+         * prepared. Returns the number of bytes that may be prepared.
+         */
+        std::size_t wait_writable(std::size_t n = 1) noexcept {
+            n = (std::min)(n, _pipe->_capacity);
+            while (true) {
+                const auto r_idx = _pipe->_consumer.read_idx.load(std::memory_order_acquire);
+                _pipe->_producer.cached_read_idx = r_idx;
+                const auto avail                 = _pipe->_capacity - (_write_idx() - r_idx);
+                if (avail >= n) {
+                    return avail;
+                }
+                _pipe->_consumer.space_waiters.wait(_pipe->_consumer.read_idx, r_idx);
+            }
+        }
+
+        /**
+         * Mark the end of the byte stream. Bytes committed before closing can
+         * still be read. The pipe must not be written after closing.
+         */
+        void close() noexcept {
+            auto& w_idx = _pipe->_producer.write_idx;
+            w_idx.fetch_or(_closed_bit, std::memory_order_release);
+            _pipe->_producer.data_waiters.notify_one(w_idx);
+        }
+    };
+
+    /**
+     * The consumer end of a pipe. Must only be used from one thread at a time.
+     */
+    class source_type {
+        spsc_byte_pipe* _pipe;
+
+        std::size_t _read_idx() const noexcept {
+            return _pipe->_consumer.read_idx.load(std::memory_order_relaxed);
+        }
+
+        std::size_t _readable(std::size_t want) const noexcept {
+            auto&      cons  = _pipe->_consumer;
+            const auto r_idx = _read_idx();
+            auto       avail = cons.cached_write_idx - r_idx;
+            if (avail < want) {
+                cons.cached_write_idx
+                    = _pipe->_producer.write_idx.load(std::memory_order_acquire) & ~_closed_bit;
+                avail = cons.cached_write_idx - r_idx;
+            }
+            return avail;
+        }
+
+    public:
+        explicit source_type(spsc_byte_pipe& p) noexcept
+            : _pipe(&p) {}
+
+        /**
+         * Obtain up to `n` bytes that have been committed by the producer. The
+         * bytes may be split in two buffers where the ring wraps around.
+         */
+        [[nodiscard]] static_buffer_vector<const_buffer, 2> next(std::size_t n) noexcept {
+            n = (std::min)(n, _readable(n));
+            return _pipe->_split<const_buffer>(_pipe->_storage.get(), _read_idx(), n);
+        }
+
+        /**
+         * Release `n` bytes back to the producer.
+         */
+        void consume(std::size_t n) noexcept {
+            neo_assert(expects,
+                       n <= _pipe->_consumer.cached_write_idx - _read_idx(),
+                       "Consumed more bytes than are available in an spsc_byte_pipe",
+                       n);
+            auto& r_idx = _pipe->_consumer.read_idx;
+            r_idx.store(r_idx.load(std::memory_order_relaxed) + n, std::memory_order_release);
+            _pipe->_consumer.space_waiters.notify_one(r_idx);
+        }
+
+        /**
+         * Block until at least `n` bytes (clamped to the pipe's capacity) are
+         * available, or until the producer closes the pipe. Returns the number
+         * of bytes available, which is zero only at the end of the stream.
+         */
+        std::size_t wait_readable(std::size_t n = 1) noexcept {
+            n = (std::min)(n, _pipe->_capacity);
+            while (true) {
+                const auto raw   = _pipe->_producer.write_idx.load(std::memory_order_acquire);
+                const auto avail = (raw & ~_closed_bit) - _read_idx();
+                _pipe->_consumer.cached_write_idx = raw & ~_closed_bit;
+                if (avail >= n || (raw & _closed_bit)) {
+                    return avail;
+                }
+                _pipe->_producer.data_waiters.wait(_pipe->_producer.write_idx, raw);
+            }
+        }
+
+        /**
+         * Determine whether the producer has closed the pipe. Bytes may still
+         * be available to read.
+         */
+        [[nodiscard]] bool closed() const noexcept {
+            return _pipe->_producer.write_idx.load(std::memory_order_acquire) & _closed_bit;
+        }
+    };
+
+    /// Obtain the producer end of the pipe
+    [[nodiscard]] sink_type sink() noexcept { return sink_type(*this); }
+    /// Obtain the consumer end of the pipe
+    [[nodiscard]] source_type source() noexcept { return source_type(*this); }
+};
+
+}  // namespace neo
@@ -0,0 +1,96 @@
+#include <neo/spsc_byte_pipe.hpp>
+
+#include <neo/buffer_algorithm.hpp>
+#include <neo/buffer_sink.hpp>
+#include <neo/buffer_source.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <thread>
+
+NEO_TEST_CONCEPT(neo::buffer_sink<neo::spsc_byte_pipe::sink_type>);
+NEO_TEST_CONCEPT(neo::buffer_source<neo::spsc_byte_pipe::source_type>);
+
+TEST_CASE("Write and read a pipe") {
+    neo::spsc_byte_pipe pipe{10};
+    CHECK(pipe.capacity() == 16);
+
+    auto sink   = pipe.sink();
+    auto source = pipe.source();
+
+    CHECK(neo::buffer_size(source.next(100)) == 0);
+    CHECK(neo::buffer_copy(sink, neo::const_buffer("Hello, world!")) == 13);
+    CHECK(neo::buffer_size(source.next(100)) == 13);
+
+    std::string str;
+    str.resize(10);
+    CHECK(neo::buffer_copy(neo::as_buffer(str), source) == 10);
+    CHECK(str == "Hello, wor");
+
+    // The free space wraps around the end of the ring
+    auto space = sink.prepare(100);
+    CHECK(neo::buffer_size(space) == 13);
+    CHECK(neo::buffer_count(space) == 2);
+    CHECK(neo::buffer_copy(space, neo::const_buffer("abcdef0123456789")) == 13);
+    sink.commit(13);
+    CHECK(neo::buffer_size(sink.prepare(1)) == 0);
+
+    str.resize(20);
+    CHECK(neo::buffer_count(source.next(100)) == 2);
+    CHECK(neo::buffer_copy(neo::as_buffer(str), source) == 16);
+    CHECK(str.substr(0, 16) == "ld!abcdef0123456");
+    CHECK(source.wait_readable(0) == 0);
+}
+
+TEST_CASE("Close a pipe") {
+    neo::spsc_byte_pipe pipe{8};
+    auto                sink   = pipe.sink();
+    auto                source = pipe.source();
+
+    neo::buffer_copy(sink, neo::const_buffer("abc"));
+    CHECK_FALSE(source.closed());
+    sink.close();
+    CHECK(source.closed());
+    // Bytes committed before the close are still readable
+    CHECK(source.wait_readable(8) == 3);
+    source.consume(3);
+    CHECK(source.wait_readable() == 0);
+}
+
+TEST_CASE("Pass bytes between threads") {
+    neo::spsc_byte_pipe pipe{64};
+    constexpr int       n_bytes = 100'000;
+
+    std::thread producer{[sink = pipe.sink()]() mutable {
+        int n_written = 0;
+        while (n_written != n_bytes) {
+            sink.wait_writable();
+            auto n = (std::min)(n_bytes - n_written, 37);
+            for (auto buf : sink.prepare(std::size_t(n))) {
+                for (std::size_t idx = 0; idx != buf.size(); ++idx) {
+                    buf[idx] = std::byte(n_written++ % 251);
+                }
+                sink.commit(buf.size());
+            }
+        }
+        sink.close();
+    }};
+
+    auto source  = pipe.source();
+    int  n_read  = 0;
+    bool matches = true;
+    while (source.wait_readable() != 0) {
+        for (auto buf : source.next(53)) {
+            for (std::size_t idx = 0; idx != buf.size(); ++idx) {
+                matches = matches && buf[idx] == std::byte(n_read++ % 251);
+            }
+            source.consume(buf.size());
+        }
+    }
+    producer.join();
+    CHECK(matches);
+    CHECK(n_read == n_bytes);
+}
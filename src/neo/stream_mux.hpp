@@ -0,0 +1,479 @@
+#pragma once
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffer_algorithm/size.hpp>
+#include <neo/buffer_sink.hpp>
+#include <neo/buffer_slice.hpp>
+#include <neo/buffer_source.hpp>
+#include <neo/byte_array.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/string_io.hpp>
+#include <neo/take_io.hpp>
+
+#include <neo/assert.hpp>
+#include <neo/fwd.hpp>
+#include <neo/ref_member.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+
+namespace neo {
+
+/**
+ * The identifier of a logical stream carried by a stream_mux.
+ */
+using mux_stream_id = std::uint32_t;
+
+/**
+ * Each frame written by a stream_mux begins with a header of this many bytes:
+ * the stream ID and then the payload length, each as a 32-bit little-endian
+ * integer.
+ */
+constexpr std::size_t mux_frame_header_size = 8;
+
+namespace detail {
+
+struct mux_frame_header {
+    mux_stream_id stream_id = 0;
+    std::uint32_t length    = 0;
+};
+
+constexpr byte_array<mux_frame_header_size> mux_encode_header(mux_frame_header hdr) noexcept {
+    byte_array<mux_frame_header_size> bytes;
+    for (std::size_t i = 0; i < 4; ++i) {
+        bytes[i]     = std::byte((hdr.stream_id >> (8 * i)) & 0xff);
+        bytes[i + 4] = std::byte((hdr.length >> (8 * i)) & 0xff);
+    }
+    return bytes;
+}
+
+constexpr mux_frame_header
+mux_decode_header(const byte_array<mux_frame_header_size>& bytes) noexcept {
+    mux_frame_header hdr;
+    for (std::size_t i = 0; i < 4; ++i) {
+        hdr.stream_id |= std::to_integer<std::uint32_t>(bytes[i]) << (8 * i);
+        hdr.length |= std::to_integer<std::uint32_t>(bytes[i + 4]) << (8 * i);
+    }
+    return hdr;
+}
+
+}  // namespace detail
+
+/**
+ * Interleaves any number of logical byte streams over a single buffer_sink.
+ *
+ * Data written to the handle returned by `stream(id)` is queued for that
+ * stream. `flush()` then writes the queued data to the sink as frames, taking
+ * the streams in turn and writing at most `max_frame_size` bytes from each
+ * before moving on to the next, so that a busy stream cannot starve the others.
+ * Each frame is written directly into the space prepared by the sink; no frame
+ * is assembled elsewhere first.
+ *
+ * With `set_direct_writes(true)`, a stream that has no queued data instead
+ * frames each write directly in the sink's prepared space, so that its bytes
+ * are not first staged in the stream's queue and then copied again by flush().
+ * Such frames are written by `commit()` rather than by flush(), and so do not
+ * take turns with the queued streams. Only one stream may have a direct write
+ * prepared at a time: while one is outstanding, the other streams queue their
+ * data as usual, and flush() must not be called.
+ *
+ * A stream's queue is kept (with its storage) until the stream is closed with
+ * `close(id)`.
+ *
+ * The frames are read back with a stream_demux.
+ */
+template <buffer_sink Sink>
+class stream_mux {
+    struct channel {
+        shifting_string_dynbuf_io pending;
+        bool                      scheduled = false;
+        /// Set by close() while data is still queued. The channel is dropped once it is flushed.
+        bool closed = false;
+    };
+
+    [[no_unique_address]] wrap_ref_member_t<Sink> _sink;
+
+    std::unordered_map<mux_stream_id, channel> _channels;
+    /// The streams that have data waiting to be written, in the order they will be visited
+    std::deque<mux_stream_id> _schedule;
+
+    std::size_t _max_frame_size = 16 * 1024;
+    bool        _direct_writes  = false;
+
+    /// The stream with an outstanding direct write, if `_direct_frame` is non-empty, and the
+    /// space prepared by the sink for that frame (including its header)
+    mux_stream_id  _direct_id = 0;
+    mutable_buffer _direct_frame;
+
+    /// Prepare space for a direct write of up to `n` bytes to the given stream. Returns an empty
+    /// buffer if the write must be queued instead.
+    mutable_buffer _prepare_direct(mux_stream_id id, std::size_t n) {
+        if (!_direct_writes || (_direct_frame.size() != 0 && _direct_id != id)) {
+            return {};
+        }
+        auto found = _channels.find(id);
+        if (found != _channels.end() && found->second.pending.available() != 0) {
+            // Direct frames must not overtake data that is already queued for this stream
+            return {};
+        }
+        n = (std::min)(n, _max_frame_size);
+        for (mutable_buffer buf : sink().prepare(mux_frame_header_size + n)) {
+            // The frame must be contiguous. If the sink's first buffer cannot hold a header and
+            // some payload, queue the write instead.
+            if (buf.size() <= mux_frame_header_size) {
+                break;
+            }
+            _direct_id    = id;
+            _direct_frame = as_buffer(buf, mux_frame_header_size + n);
+            return _direct_frame + mux_frame_header_size;
+        }
+        _direct_frame = {};
+        return {};
+    }
+
+    mutable_buffer _prepare(mux_stream_id id, std::size_t n) {
+        if (n == 0) {
+            // Nothing to write, so there is no need to open a queue for it
+            return {};
+        }
+        if (auto direct = _prepare_direct(id, n); direct.size() != 0) {
+            return direct;
+        }
+        auto& chan  = _channels[id];
+        chan.closed = false;
+        return chan.pending.prepare(n);
+    }
+
+    void _commit(mux_stream_id id, std::size_t n) noexcept(noexcept(sink().commit(n))) {
+        if (_direct_frame.size() != 0 && _direct_id == id) {
+            neo_assert(expects,
+                       n <= _direct_frame.size() - mux_frame_header_size,
+                       "Attempted to commit more bytes to a stream_mux stream than were prepared",
+                       id,
+                       n,
+                       _direct_frame.size() - mux_frame_header_size);
+            if (n != 0) {
+                const auto header
+                    = detail::mux_encode_header({id, static_cast<std::uint32_t>(n)});
+                buffer_copy(_direct_frame, as_buffer(header));
+                sink().commit(mux_frame_header_size + n);
+            }
+            _direct_frame = {};
+            return;
+        }
+        auto found = _channels.find(id);
+        if (found == _channels.end() && n == 0) {
+            return;
+        }
+        neo_assert(expects,
+                   found != _channels.end(),
+                   "Attempted to commit to a stream_mux stream that was not prepared",
+                   id,
+                   n);
+        auto& chan = found->second;
+        chan.pending.commit(n);
+        if (!chan.scheduled && n != 0) {
+            chan.scheduled = true;
+            _schedule.push_back(id);
+        }
+    }
+
+    /// Write a single frame from the given channel. Returns the payload size, or zero if the
+    /// sink is full.
+    std::size_t _write_frame(mux_stream_id id, channel& chan) {
+        auto len = (std::min)(chan.pending.available(), _max_frame_size);
+        auto out = sink().prepare(mux_frame_header_size + len);
+
+        const auto room = buffer_size(out);
+        if (room <= mux_frame_header_size) {
+            return 0;
+        }
+        len = (std::min)(len, room - mux_frame_header_size);
+
+        const auto header = detail::mux_encode_header({id, static_cast<std::uint32_t>(len)});
+        buffer_copy(out, as_buffer(header));
+        buffer_copy(buffer_slice(out, mux_frame_header_size), chan.pending.next(len));
+        chan.pending.consume(len);
+        sink().commit(mux_frame_header_size + len);
+        return len;
+    }
+
+public:
+    /**
+     * A buffer_sink that writes to one logical stream of a stream_mux. The
+     * written data is queued until the mux is flushed.
+     */
+    class stream_sink {
+        stream_mux*   _mux = nullptr;
+        mux_stream_id _id  = 0;
+
+    public:
+        stream_sink() = default;
+        stream_sink(stream_mux& mux, mux_stream_id id) noexcept
+            : _mux(&mux)
+            , _id(id) {}
+
+        [[nodiscard]] mux_stream_id id() const noexcept { return _id; }
+
+        mutable_buffer prepare(std::size_t n) { return _mux->_prepare(_id, n); }
+        void commit(std::size_t n) noexcept(noexcept(_mux->_commit(_id, n))) {
+            _mux->_commit(_id, n);
+        }
+    };
+
+    stream_mux() = default;
+
+    explicit stream_mux(Sink&& s) noexcept
+        : _sink(NEO_FWD(s)) {}
+
+    NEO_DECL_UNREF_GETTER(sink, _sink);
+
+    /**
+     * Obtain a sink that writes to the stream with the given ID.
+     */
+    [[nodiscard]] stream_sink stream(mux_stream_id id) noexcept { return stream_sink(*this, id); }
+
+    /**
+     * Set the largest payload that will be written in a single frame, and so the
+     * number of bytes written from one stream before the next is given a turn.
+     */
+    void set_max_frame_size(std::size_t n) noexcept {
+        neo_assert(expects,
+                   n != 0 && n <= UINT32_MAX,
+                   "stream_mux frame size must be non-zero and fit in 32 bits",
+                   n);
+        _max_frame_size = n;
+    }
+
+    /**
+     * Enable or disable direct writes by streams that have no queued data. (See
+     * the class documentation.)
+     */
+    void set_direct_writes(bool enable) noexcept { _direct_writes = enable; }
+
+    /**
+     * Close the stream with the given ID, releasing the storage of its queue.
+     * Data that is already queued for the stream is still written by flush(),
+     * after which the stream is dropped. Writing to the stream again opens it
+     * anew.
+     */
+    void close(mux_stream_id id) noexcept {
+        auto found = _channels.find(id);
+        if (found == _channels.end()) {
+            return;
+        }
+        if (found->second.scheduled) {
+            found->second.closed = true;
+        } else {
+            _channels.erase(found);
+        }
+    }
+
+    /**
+     * The number of streams that hold a queue, i.e. that have been written to
+     * through the queue and not yet closed.
+     */
+    [[nodiscard]] std::size_t open_streams() const noexcept { return _channels.size(); }
+
+    /**
+     * The number of bytes that have been written to streams and not yet flushed.
+     */
+    [[nodiscard]] std::size_t pending_bytes() const noexcept {
+        std::size_t total = 0;
+        for (auto id : _schedule) {
+            total += _channels.find(id)->second.pending.available();
+        }
+        return total;
+    }
+
+    /**
+     * Write queued data to the sink as frames, visiting the streams in turn,
+     * until no data remains or the sink can accept no more. Returns the number
+     * of payload bytes written.
+     */
+    std::size_t flush() {
+        neo_assert(expects,
+                   _direct_frame.size() == 0,
+                   "stream_mux::flush() was called while a direct write was prepared",
+                   _direct_id);
+        std::size_t total = 0;
+        while (!_schedule.empty()) {
+            const auto id   = _schedule.front();
+            auto&      chan = _channels[id];
+            const auto n    = _write_frame(id, chan);
+            if (n == 0) {
+                break;
+            }
+            total += n;
+            _schedule.pop_front();
+            if (chan.pending.available() != 0) {
+                // Give the other streams a turn before this one continues
+                _schedule.push_back(id);
+            } else if (chan.closed) {
+                _channels.erase(id);
+            } else {
+                chan.scheduled = false;
+            }
+        }
+        return total;
+    }
+};
+
+template <typename S>
+explicit stream_mux(S&&) -> stream_mux<S>;
+
+/**
+ * Reads the logical streams written by a stream_mux back out of a single
+ * buffer_source.
+ *
+ * Each stream is read through the handle returned by `stream(id)`. When the
+ * frame at the front of the source belongs to the stream being read, its
+ * payload is returned as a view directly into the source's buffers. Frames
+ * that belong to other streams are copied aside until those streams are read.
+ */
+template <buffer_source Source>
+class stream_demux {
+    [[no_unique_address]] wrap_ref_member_t<Source> _source;
+
+    /// Data that has been read from the source for each stream but not yet consumed
+    std::unordered_map<mux_stream_id, shifting_string_dynbuf_io> _stashed;
+
+    byte_array<mux_frame_header_size> _header_bytes;
+    std::size_t                       _header_size = 0;
+
+    /// The stream of the current frame, and the number of its payload bytes still to be read
+    mux_stream_id _frame_id        = 0;
+    std::size_t   _frame_remaining = 0;
+
+    /// Read the next frame header. Returns false if the source does not have a full header.
+    bool _read_header() {
+        while (_header_size != mux_frame_header_size) {
+            auto dest = as_buffer(_header_bytes) + _header_size;
+            auto n    = buffer_copy(dest, source(), dest.size());
+            if (n == 0) {
+                return false;
+            }
+            _header_size += n;
+        }
+        _header_size     = 0;
+        const auto hdr   = detail::mux_decode_header(_header_bytes);
+        _frame_id        = hdr.stream_id;
+        _frame_remaining = hdr.length;
+        return true;
+    }
+
+    const_buffer _next(mux_stream_id id, std::size_t n) {
+        auto found = _stashed.find(id);
+        if (found != _stashed.end() && found->second.available() != 0) {
+            return found->second.next(n);
+        }
+        while (true) {
+            if (_frame_remaining == 0) {
+                if (!_read_header()) {
+                    return const_buffer();
+                }
+                continue;
+            }
+            if (_frame_id == id) {
+                auto bufs = source().next((std::min)(n, _frame_remaining));
+                for (const_buffer buf : bufs) {
+                    if (buf.size() != 0) {
+                        return as_buffer(buf, (std::min)(n, _frame_remaining));
+                    }
+                }
+                return const_buffer();
+            }
+            // The current frame belongs to another stream. Set it aside.
+            auto moved = buffer_copy(_stashed[_frame_id], take_source(source(), _frame_remaining));
+            if (moved == 0) {
+                return const_buffer();
+            }
+            _frame_remaining -= moved;
+        }
+    }
+
+    void _consume(mux_stream_id id, std::size_t n) noexcept {
+        auto found = _stashed.find(id);
+        if (found != _stashed.end() && found->second.available() != 0) {
+            found->second.consume(n);
+            return;
+        }
+        neo_assert(expects,
+                   n == 0 || (_frame_id == id && n <= _frame_remaining),
+                   "Attempted to consume more bytes from a demuxed stream than are available",
+                   id,
+                   n,
+                   _frame_id,
+                   _frame_remaining);
+        source().consume(n);
+        _frame_remaining -= n;
+    }
+
+public:
+    /**
+     * A buffer_source that reads one logical stream of a stream_demux.
+     */
+    class stream_source {
+        stream_demux* _demux = nullptr;
+        mux_stream_id _id    = 0;
+
+    public:
+        stream_source() = default;
+        stream_source(stream_demux& demux, mux_stream_id id) noexcept
+            : _demux(&demux)
+            , _id(id) {}
+
+        [[nodiscard]] mux_stream_id id() const noexcept { return _id; }
+
+        const_buffer next(std::size_t n) { return _demux->_next(_id, n); }
+        void         consume(std::size_t n) noexcept { _demux->_consume(_id, n); }
+    };
+
+    stream_demux() = default;
+
+    explicit stream_demux(Source&& s) noexcept
+        : _source(NEO_FWD(s)) {}
+
+    NEO_DECL_UNREF_GETTER(source, _source);
+
+    /**
+     * Obtain a source that reads the stream with the given ID.
+     */
+    [[nodiscard]] stream_source stream(mux_stream_id id) noexcept {
+        return stream_source(*this, id);
+    }
+
+    /**
+     * Release the stream with the given ID, discarding any data that has been
+     * copied aside for it and releasing the storage that held it. Frames for
+     * the stream that arrive afterwards are copied aside again as usual.
+     */
+    void release(mux_stream_id id) noexcept { _stashed.erase(id); }
+
+    /**
+     * The number of streams that hold data copied aside, or storage for it,
+     * and have not been released.
+     */
+    [[nodiscard]] std::size_t stashed_streams() const noexcept { return _stashed.size(); }
+
+    /**
+     * The number of bytes that have been copied aside for streams other than
+     * the one being read, and not yet consumed.
+     */
+    [[nodiscard]] std::size_t stashed_bytes() const noexcept {
+        std::size_t total = 0;
+        for (auto& [id, stash] : _stashed) {
+            total += stash.available();
+        }
+        return total;
+    }
+};
+
+template <typename S>
+explicit stream_demux(S&&) -> stream_demux<S>;
+
+}  // namespace neo
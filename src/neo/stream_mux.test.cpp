@@ -0,0 +1,147 @@
+#include <neo/stream_mux.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffers_consumer.hpp>
+#include <neo/string_io.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+NEO_TEST_CONCEPT(neo::buffer_sink<neo::stream_mux<neo::string_dynbuf_io&>::stream_sink>);
+NEO_TEST_CONCEPT(neo::buffer_source<neo::stream_demux<neo::string_dynbuf_io&>::stream_source>);
+
+namespace {
+
+std::string read_all(neo::buffer_source auto&& src) {
+    neo::string_dynbuf_io out;
+    neo::buffer_copy(out, src);
+    return std::string(out.read_area_view());
+}
+
+}  // namespace
+
+TEST_CASE("Send two streams over one connection") {
+    neo::string_dynbuf_io wire;
+    neo::stream_mux       mux{wire};
+
+    auto a = mux.stream(1);
+    auto b = mux.stream(2);
+    neo::buffer_copy(a, neo::as_buffer(std::string("Hello from A")));
+    neo::buffer_copy(b, neo::as_buffer(std::string("Hello from B")));
+    CHECK(mux.pending_bytes() == 24);
+    CHECK(wire.available() == 0);
+
+    CHECK(mux.flush() == 24);
+    CHECK(mux.pending_bytes() == 0);
+    CHECK(wire.available() == 24 + 2 * neo::mux_frame_header_size);
+
+    neo::stream_demux demux{wire};
+    // Reading stream 2 first sets aside the frame for stream 1
+    CHECK(read_all(demux.stream(2)) == "Hello from B");
+    CHECK(demux.stashed_bytes() == 12);
+    CHECK(read_all(demux.stream(1)) == "Hello from A");
+    CHECK(demux.stashed_bytes() == 0);
+}
+
+TEST_CASE("Streams are interleaved fairly") {
+    neo::string_dynbuf_io wire;
+    neo::stream_mux       mux{wire};
+    mux.set_max_frame_size(4);
+
+    auto big   = mux.stream(7);
+    auto small = mux.stream(8);
+    neo::buffer_copy(big, neo::as_buffer(std::string("aaaabbbbccccdddd")));
+    neo::buffer_copy(small, neo::as_buffer(std::string("xy")));
+    mux.flush();
+
+    // The small stream's frame is sent after the first frame of the large stream, not after all
+    // of them
+    neo::stream_demux demux{wire};
+    auto              second_frame = wire.read_area_view().substr(12, 8);
+    CHECK(second_frame.substr(0, 4) == std::string_view("\x08\x00\x00\x00", 4));
+    CHECK(read_all(demux.stream(8)) == "xy");
+    CHECK(read_all(demux.stream(7)) == "aaaabbbbccccdddd");
+}
+
+TEST_CASE("Payload of the current frame is a view of the source") {
+    neo::string_dynbuf_io wire;
+    neo::stream_mux       mux{wire};
+    neo::buffer_copy(mux.stream(3), neo::as_buffer(std::string("zero-copy")));
+    mux.flush();
+
+    neo::stream_demux demux{wire};
+    auto              src = demux.stream(3);
+    auto              buf = src.next(1024);
+    CHECK(buf.size() == 9);
+    CHECK(buf.data() == neo::as_buffer(wire.read_area_view()).data());
+    src.consume(buf.size());
+    CHECK(src.next(1024).size() == 0);
+}
+
+TEST_CASE("Flush stops when the sink is full") {
+    std::string           storage(30, '.');
+    neo::buffers_consumer wire{neo::as_buffer(storage)};
+    neo::stream_mux       mux{wire};
+
+    neo::buffer_copy(mux.stream(1), neo::as_buffer(std::string("0123456789")));
+    neo::buffer_copy(mux.stream(2), neo::as_buffer(std::string("abcdefghij")));
+    // The first frame fits whole, and the second is cut short
+    CHECK(mux.flush() == 14);
+    CHECK(mux.pending_bytes() == 6);
+    CHECK(storage.substr(26) == "abcd");
+}
+
+TEST_CASE("A stream with nothing queued writes frames directly into the sink") {
+    neo::string_dynbuf_io wire;
+    neo::stream_mux       mux{wire};
+    mux.set_direct_writes(true);
+
+    auto a = mux.stream(1);
+    neo::buffer_copy(a, neo::as_buffer(std::string("Hello from A")));
+    // Nothing was queued: The frame is already in the sink
+    CHECK(mux.pending_bytes() == 0);
+    CHECK(mux.open_streams() == 0);
+    CHECK(wire.available() == 12 + neo::mux_frame_header_size);
+
+    // While A's write is prepared, B's write is queued
+    auto a_buf = a.prepare(5);
+    neo::buffer_copy(mux.stream(2), neo::as_buffer(std::string("B")));
+    neo::buffer_copy(a_buf, neo::as_buffer(std::string("again")));
+    a.commit(5);
+    CHECK(mux.pending_bytes() == 1);
+    CHECK(mux.flush() == 1);
+
+    neo::stream_demux demux{wire};
+    CHECK(read_all(demux.stream(2)) == "B");
+    CHECK(read_all(demux.stream(1)) == "Hello from Aagain");
+}
+
+TEST_CASE("Closed and released streams give up their storage") {
+    neo::string_dynbuf_io wire;
+    neo::stream_mux       mux{wire};
+
+    for (neo::mux_stream_id id = 0; id < 100; ++id) {
+        neo::buffer_copy(mux.stream(id), neo::as_buffer(std::string("payload")));
+    }
+    CHECK(mux.open_streams() == 100);
+    // Streams with queued data are dropped once it is flushed
+    for (neo::mux_stream_id id = 0; id < 100; ++id) {
+        mux.close(id);
+    }
+    CHECK(mux.open_streams() == 100);
+    CHECK(mux.flush() == 700);
+    CHECK(mux.open_streams() == 0);
+
+    neo::stream_demux demux{wire};
+    CHECK(read_all(demux.stream(99)) == "payload");
+    CHECK(demux.stashed_streams() == 99);
+    for (neo::mux_stream_id id = 0; id < 99; ++id) {
+        CHECK(read_all(demux.stream(id)) == "payload");
+        demux.release(id);
+    }
+    CHECK(demux.stashed_streams() == 0);
+}
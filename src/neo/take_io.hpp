@@ -0,0 +1,100 @@
+#pragma once
+
+#include <neo/buffer_algorithm/size.hpp>
+#include <neo/buffer_sink.hpp>
+#include <neo/buffer_slice.hpp>
+#include <neo/buffer_source.hpp>
+
+#include <neo/assert.hpp>
+#include <neo/fwd.hpp>
+#include <neo/ref_member.hpp>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace neo {
+
+/**
+ * A buffer_source that yields at most `limit` bytes from another source, in the
+ * same way that the `clamp_size` of a buffers_consumer limits a buffer range.
+ * Bytes beyond the limit are left unread in the underlying source.
+ */
+template <buffer_source Source>
+class take_source {
+    [[no_unique_address]] wrap_ref_member_t<Source> _source;
+
+    std::size_t _remaining = 0;
+
+public:
+    constexpr take_source() = default;
+
+    constexpr explicit take_source(Source&& s, std::size_t limit) noexcept
+        : _source(NEO_FWD(s))
+        , _remaining(limit) {}
+
+    NEO_DECL_UNREF_GETTER(source, _source);
+
+    /// The number of bytes that may still be read
+    [[nodiscard]] constexpr std::size_t remaining() const noexcept { return _remaining; }
+
+    constexpr auto next(std::size_t n) noexcept(noexcept(source().next(n))) {
+        n = (std::min)(n, _remaining);
+        return buffer_slice(source().next(n), 0, n);
+    }
+
+    constexpr void consume(std::size_t n) noexcept {
+        neo_assert(expects,
+                   n <= _remaining,
+                   "Attempted to consume more bytes from a take_source than its limit allows",
+                   n,
+                   _remaining);
+        source().consume(n);
+        _remaining -= n;
+    }
+};
+
+template <typename S>
+explicit take_source(S&&, std::size_t) -> take_source<S>;
+
+/**
+ * A buffer_sink that accepts at most `limit` bytes, passing them to another
+ * sink. Once the limit is reached, the sink prepares only empty buffers.
+ */
+template <buffer_sink Sink>
+class take_sink {
+    [[no_unique_address]] wrap_ref_member_t<Sink> _sink;
+
+    std::size_t _remaining = 0;
+
+public:
+    constexpr take_sink() = default;
+
+    constexpr explicit take_sink(Sink&& s, std::size_t limit) noexcept
+        : _sink(NEO_FWD(s))
+        , _remaining(limit) {}
+
+    NEO_DECL_UNREF_GETTER(sink, _sink);
+
+    /// The number of bytes that may still be written
+    [[nodiscard]] constexpr std::size_t remaining() const noexcept { return _remaining; }
+
+    constexpr auto prepare(std::size_t n) noexcept(noexcept(sink().prepare(n))) {
+        n = (std::min)(n, _remaining);
+        return buffer_slice(sink().prepare(n), 0, n);
+    }
+
+    constexpr void commit(std::size_t n) noexcept(noexcept(sink().commit(n))) {
+        neo_assert(expects,
+                   n <= _remaining,
+                   "Attempted to commit more bytes to a take_sink than its limit allows",
+                   n,
+                   _remaining);
+        sink().commit(n);
+        _remaining -= n;
+    }
+};
+
+template <typename S>
+explicit take_sink(S&&, std::size_t) -> take_sink<S>;
+
+}  // namespace neo
@@ -0,0 +1,44 @@
+#include <neo/take_io.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffers_consumer.hpp>
+#include <neo/string_io.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+NEO_TEST_CONCEPT(neo::buffer_source<neo::take_source<neo::proto_buffer_source&>>);
+NEO_TEST_CONCEPT(neo::buffer_sink<neo::take_sink<neo::proto_buffer_sink&>>);
+NEO_TEST_CONCEPT(neo::buffer_sink<neo::take_sink<neo::string_dynbuf_io&>>);
+
+TEST_CASE("Read a limited number of bytes from a source") {
+    neo::buffers_consumer in{neo::as_buffer("Content of the body|Next request", 32)};
+
+    neo::take_source body{in, 19};
+    CHECK(body.remaining() == 19);
+
+    neo::string_dynbuf_io out;
+    auto                  n = neo::buffer_copy(out, body);
+    CHECK(n == 19);
+    CHECK(body.remaining() == 0);
+    CHECK(out.read_area_view() == "Content of the body");
+
+    // The rest is left in the underlying source
+    CHECK(neo::buffer_size(in.next(1024)) == 13);
+}
+
+TEST_CASE("Write a limited number of bytes to a sink") {
+    neo::string_dynbuf_io out;
+    neo::take_sink        limited{out, 5};
+
+    auto n = neo::buffer_copy(limited, neo::as_buffer("Hello, world!", 13));
+    CHECK(n == 5);
+    CHECK(limited.remaining() == 0);
+    CHECK(neo::buffer_size(limited.prepare(10)) == 0);
+    out.shrink_uncommitted();
+    CHECK(out.read_area_view() == "Hello");
+}
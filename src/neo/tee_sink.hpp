@@ -0,0 +1,189 @@
+#pragma once
+
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffer_sink.hpp>
+#include <neo/buffer_slice.hpp>
+
+#include <neo/assert.hpp>
+#include <neo/fwd.hpp>
+#include <neo/ref_member.hpp>
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace neo {
+
+namespace detail {
+
+template <typename Sink>
+using sink_prepare_t = std::remove_cvref_t<decltype(
+    unref(std::declval<wrap_ref_member_t<Sink>&>()).prepare(std::size_t()))>;
+
+}  // namespace detail
+
+/**
+ * A buffer_sink that writes everything committed to it to each of `Sinks`.
+ *
+ * The first sink is the primary: `prepare()` returns the space prepared by the
+ * primary sink, so data is written there directly. When the data is committed
+ * it is copied from that space into each of the other sinks, and then committed
+ * to the primary sink. Mirroring to N sinks therefore costs N - 1 copies.
+ *
+ * A secondary sink that prepares fewer bytes than are committed to the tee will
+ * receive only part of the data. The number of bytes accepted by each sink is
+ * available from `bytes_committed()`.
+ *
+ * The same sink must not be given more than once.
+ */
+template <buffer_sink... Sinks>
+class tee_sink {
+    static_assert(sizeof...(Sinks) != 0, "tee_sink requires at least one sink");
+
+    constexpr static std::size_t _n_sinks = sizeof...(Sinks);
+
+    using _primary_type  = std::tuple_element_t<0, std::tuple<Sinks...>>;
+    using _prepared_type = detail::sink_prepare_t<_primary_type>;
+
+    [[no_unique_address]] std::tuple<wrap_ref_member_t<Sinks>...> _sinks;
+
+    /// The space most recently prepared by the primary sink
+    _prepared_type _prepared{};
+
+    std::array<std::size_t, _n_sinks> _committed{};
+
+    template <typename Data, std::size_t... Is>
+    constexpr void _copy_to_secondaries(Data&& data, std::index_sequence<Is...>) {
+        ((_committed[Is + 1] += buffer_copy(sink<Is + 1>(), data)), ...);
+    }
+
+public:
+    constexpr tee_sink() = default;
+
+    constexpr explicit tee_sink(Sinks&&... sinks) noexcept
+        : _sinks(NEO_FWD(sinks)...) {}
+
+    template <std::size_t I>
+    constexpr decltype(auto) sink() noexcept {
+        return unref(std::get<I>(_sinks));
+    }
+
+    template <std::size_t I>
+    constexpr decltype(auto) sink() const noexcept {
+        return unref(std::get<I>(_sinks));
+    }
+
+    constexpr auto prepare(std::size_t n) noexcept(noexcept(sink<0>().prepare(n))) {
+        _prepared = sink<0>().prepare(n);
+        return _prepared;
+    }
+
+    constexpr void commit(std::size_t n) {
+        neo_assert(expects,
+                   n <= buffer_size(_prepared),
+                   "Attempted to commit more bytes to a tee_sink than were prepared",
+                   n,
+                   buffer_size(_prepared));
+        // Copy out before committing, as committing may invalidate the prepared space
+        _copy_to_secondaries(buffer_slice(_prepared, 0, n),
+                             std::make_index_sequence<_n_sinks - 1>{});
+        sink<0>().commit(n);
+        _committed[0] += n;
+    }
+
+    /**
+     * The number of bytes committed to the sink at `index`.
+     */
+    constexpr std::size_t bytes_committed(std::size_t index) const noexcept {
+        neo_assert(expects, index < _n_sinks, "tee_sink index is out of range", index, _n_sinks);
+        return _committed[index];
+    }
+
+    /**
+     * The number of bytes committed to each sink.
+     */
+    constexpr const std::array<std::size_t, _n_sinks>& bytes_committed() const noexcept {
+        return _committed;
+    }
+};
+
+template <typename... Sinks>
+explicit tee_sink(Sinks&&...) -> tee_sink<Sinks...>;
+
+/**
+ * A tee_sink over a number of sinks of the same type that is decided at
+ * runtime. The first sink added is the primary sink. At least one sink must be
+ * added before the tee is written to.
+ */
+template <buffer_sink Sink>
+class dynamic_tee_sink {
+    using _prepared_type = detail::sink_prepare_t<Sink>;
+
+    std::vector<wrap_ref_member_t<Sink>> _sinks;
+    std::vector<std::size_t>             _committed;
+
+    _prepared_type _prepared{};
+
+public:
+    dynamic_tee_sink() = default;
+
+    /**
+     * Add a sink to the tee. Returns the index of the new sink.
+     */
+    std::size_t add_sink(Sink&& s) {
+        _sinks.emplace_back(NEO_FWD(s));
+        _committed.push_back(0);
+        return _sinks.size() - 1;
+    }
+
+    [[nodiscard]] std::size_t sink_count() const noexcept { return _sinks.size(); }
+
+    decltype(auto) sink(std::size_t index) noexcept {
+        neo_assert(expects,
+                   index < _sinks.size(),
+                   "dynamic_tee_sink index is out of range",
+                   index,
+                   _sinks.size());
+        return unref(_sinks[index]);
+    }
+
+    auto prepare(std::size_t n) {
+        neo_assert(expects,
+                   !_sinks.empty(),
+                   "Attempted to prepare a dynamic_tee_sink with no sinks",
+                   n);
+        _prepared = sink(0).prepare(n);
+        return _prepared;
+    }
+
+    void commit(std::size_t n) {
+        neo_assert(expects,
+                   n <= buffer_size(_prepared),
+                   "Attempted to commit more bytes to a dynamic_tee_sink than were prepared",
+                   n,
+                   buffer_size(_prepared));
+        auto data = buffer_slice(_prepared, 0, n);
+        for (std::size_t i = 1; i < _sinks.size(); ++i) {
+            _committed[i] += buffer_copy(sink(i), data);
+        }
+        sink(0).commit(n);
+        _committed[0] += n;
+    }
+
+    /**
+     * The number of bytes committed to the sink at `index`.
+     */
+    std::size_t bytes_committed(std::size_t index) const noexcept {
+        neo_assert(expects,
+                   index < _committed.size(),
+                   "dynamic_tee_sink index is out of range",
+                   index,
+                   _committed.size());
+        return _committed[index];
+    }
+};
+
+}  // namespace neo
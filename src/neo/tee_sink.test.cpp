@@ -0,0 +1,80 @@
+#include <neo/tee_sink.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffers_consumer.hpp>
+#include <neo/string_io.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+NEO_TEST_CONCEPT(neo::buffer_sink<neo::tee_sink<neo::string_dynbuf_io&, neo::string_dynbuf_io&>>);
+NEO_TEST_CONCEPT(neo::buffer_sink<neo::dynamic_tee_sink<neo::string_dynbuf_io&>>);
+
+TEST_CASE("Write to two sinks at once") {
+    neo::string_dynbuf_io live;
+    neo::string_dynbuf_io capture;
+
+    neo::tee_sink tee{live, capture};
+
+    const std::string str = "Mirrored to both sinks";
+    auto              n   = neo::buffer_copy(tee, neo::as_buffer(str));
+    CHECK(n == str.size());
+    live.shrink_uncommitted();
+    capture.shrink_uncommitted();
+    CHECK(live.read_area_view() == str);
+    CHECK(capture.read_area_view() == str);
+    CHECK(tee.bytes_committed(0) == str.size());
+    CHECK(tee.bytes_committed(1) == str.size());
+}
+
+TEST_CASE("Data is written directly to the primary sink") {
+    neo::string_dynbuf_io live;
+    neo::string_dynbuf_io capture;
+
+    neo::tee_sink tee{live, capture};
+
+    auto buf = tee.prepare(5);
+    CHECK(neo::buffer_size(buf) >= 5);
+    CHECK(buf.data() == live.prepare(5).data());
+    neo::buffer_copy(buf, neo::as_buffer("Hello", 5));
+    tee.commit(5);
+    CHECK(live.read_area_view() == "Hello");
+    CHECK(capture.read_area_view() == "Hello");
+}
+
+TEST_CASE("Report a sink that accepts less than was committed") {
+    neo::string_dynbuf_io live;
+
+    std::string           small_str = "....";
+    neo::buffers_consumer small{neo::as_buffer(small_str)};
+
+    neo::tee_sink tee{live, small};
+
+    const std::string str = "Too long for the second sink";
+    neo::buffer_copy(tee, neo::as_buffer(str));
+    CHECK(tee.bytes_committed(0) == str.size());
+    CHECK(tee.bytes_committed(1) == 4);
+    CHECK(small_str == "Too ");
+}
+
+TEST_CASE("Write to a runtime number of sinks") {
+    neo::string_dynbuf_io sinks[3];
+
+    neo::dynamic_tee_sink<neo::string_dynbuf_io&> tee;
+    for (auto& s : sinks) {
+        tee.add_sink(s);
+    }
+    CHECK(tee.sink_count() == 3);
+
+    const std::string str = "Hello, world!";
+    neo::buffer_copy(tee, neo::as_buffer(str));
+    neo::buffer_copy(tee, neo::as_buffer(str));
+    for (auto& s : sinks) {
+        s.shrink_uncommitted();
+        CHECK(s.read_area_view() == str + str);
+    }
+    CHECK(tee.bytes_committed(2) == 2 * str.size());
+}
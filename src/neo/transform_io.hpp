@@ -2,16 +2,28 @@
 
 #include "./as_dynamic_buffer.hpp"
 #include "./buffer_algorithm/transform.hpp"
+#include "./buffer_algorithm/transform_inplace.hpp"
 #include "./buffer_sink.hpp"
+#include "./buffer_slice.hpp"
 #include "./string_io.hpp"
 
 #include <neo/fwd.hpp>
 #include <neo/ref_member.hpp>
 
 #include <string>
+#include <type_traits>
 
 namespace neo {
 
+/**
+ * A buffer_sink that passes the data committed to it through a transformer
+ * before writing it to `Sink`.
+ *
+ * If `Transform` is an inplace_buffer_transformer (it has opted in through
+ * `buffer_transformer_is_inplace_v`), the data is transformed directly within
+ * the space prepared by `Sink`, and `DynBuffer` is unused.
+ * Otherwise, the data is collected in `DynBuffer` and transformed from there.
+ */
 template <buffer_sink        Sink,
           buffer_transformer Transform,
           dynamic_buffer     DynBuffer = shifting_string_buffer>
@@ -20,6 +32,31 @@ class buffer_transform_sink {
     [[no_unique_address]] wrap_ref_member_t<Transform> _transformer;
     [[no_unique_address]] wrap_ref_member_t<DynBuffer> _buffer;
 
+    constexpr static bool _inplace = inplace_buffer_transformer<Transform>;
+
+    struct _no_prepared {};
+    using _prepared_type = std::conditional_t<
+        _inplace,
+        std::remove_cvref_t<decltype(std::declval<Sink&>().prepare(std::size_t()))>,
+        _no_prepared>;
+
+    /// The buffers most recently prepared by the sink, when transforming in place
+    [[no_unique_address]] _prepared_type _prepared{};
+
+    constexpr static bool _commit_is_noexcept() noexcept {
+        using sink_ref = std::remove_reference_t<Sink>&;
+        using tr_ref   = std::remove_reference_t<Transform>&;
+        if constexpr (_inplace) {
+            return noexcept(std::declval<tr_ref>()(mutable_buffer()))
+                && noexcept(std::declval<sink_ref>().commit(std::size_t()));
+        } else {
+            using dynbuf_ref = std::remove_reference_t<DynBuffer>&;
+            return noexcept(buffer_transform(std::declval<tr_ref>(),
+                                             std::declval<sink_ref>(),
+                                             std::declval<dynbuf_ref>().data(1, 1)));
+        }
+    }
+
 public:
     constexpr buffer_transform_sink() = default;
     constexpr explicit buffer_transform_sink(Sink&& s) noexcept
@@ -38,7 +75,30 @@ public:
     NEO_DECL_UNREF_GETTER(transformer, _transformer);
     NEO_DECL_UNREF_GETTER(buffer, _buffer);
 
-    auto prepare(std::size_t prep_size) noexcept(noexcept(buffer().grow(prep_size))) {
+    auto prepare(std::size_t prep_size) noexcept(
+        _inplace ? noexcept(sink().prepare(prep_size)) : noexcept(buffer().grow(prep_size))) {
+        if constexpr (_inplace) {
+            _prepared = sink().prepare(prep_size);
+            return _prepared;
+        } else {
+            return _prepare_buffered(prep_size);
+        }
+    }
+
+    void commit(std::size_t n) noexcept(_commit_is_noexcept()) {
+        if constexpr (_inplace) {
+            buffer_transform_inplace(transformer(), buffer_slice(_prepared, 0, n));
+            sink().commit(n);
+        } else {
+            auto&  buf     = buffer();
+            auto&& databuf = buf.data(0, n);
+            buffer_transform(transformer(), sink(), databuf);
+            buf.consume(n);
+        }
+    }
+
+private:
+    auto _prepare_buffered(std::size_t prep_size) {
         auto& buf   = buffer();
         auto  avail = buf.size();
         if (avail >= prep_size) {
@@ -48,15 +108,6 @@ public:
         dynbuf_safe_grow(buf, more_size);
         return buf.data(0, buf.size());
     }
-
-    void commit(std::size_t n) noexcept(
-        noexcept(buffer_transform(transformer(), sink(), buffer().data(1, 1))))  //
-    {
-        auto&  buf     = buffer();
-        auto&& databuf = buf.data(0, n);
-        buffer_transform(transformer(), sink(), databuf);
-        buf.consume(n);
-    }
 };
 
 template <typename S, typename Tr>